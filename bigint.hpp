@@ -6,1038 +6,5098 @@
  * @date 2024-12-20
  * @brief The header file for the bigint class.
  *
- * This file contains the declaration of the bigint class, also overloaded operators
+ * This file contains the declaration of the basic_bigint class template and its bigint alias, also overloaded operators
  * and necessary member functions for arithmetic operations, comparisons, and other functions.
  */
 
 #include <string>    // std::string for string manipulation
 #include <vector>    // std::vector for dynamic arrays
+#include <deque>     // std::deque for the per-thread table of powers of ten
 #include <iostream>  // std::cout for output
 #include <stdexcept> // std::invalid_argument, std::logic_error for exceptions
+#include <cstdint>   // uint64_t for the limbs
+#include <algorithm> // std::copy, std::fill for limb buffers
+#include <bit>       // std::countl_zero for the division normalization
+#include <cmath>     // std::log2 for the number of digits in other bases
+#include <utility>   // std::pair for divmod
+#include <concepts>  // std::integral for the operators taking native integers
+#include <compare>   // std::strong_ordering for the comparisons with native integers
+#include <memory>    // std::allocator, std::allocator_traits for the limb buffers that do not fit inline
+#include <memory_resource> // std::pmr::polymorphic_allocator for the pmr_bigint aliases
+#include <charconv>  // std::to_chars_result, std::from_chars_result for the character conversions
+#include <string_view> // std::string_view for the stream output
+#if defined(__has_include)
+#if __has_include(<format>)
+#include <format> // std::formatter, when the standard library provides it
+#endif
+#endif
+#if defined(__x86_64__)
+#include <immintrin.h> // _addcarry_u64, _subborrow_u64 for the carry chains, AVX2 and AVX-512 for the vectorized kernels
+#endif
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+#define BIGINT_HAS_BUILTIN_ADDC // Clang and GCC 14 provide add-with-carry builtins on every target
+#endif
+#endif
 
 /**
- * @class bigint
- * @brief A class for handling big integers
- *
- * This class provides operations for big integers, including initialization, addition, subtraction, multiplication, division,
- * modulus, and comparison operations.
+ * @brief Operand size (in limbs) from which multiplication switches from schoolbook to Karatsuba.
+ * Define it before including this header to tune it for a specific machine.
  */
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#define BIGINT_KARATSUBA_THRESHOLD 24
+#endif
+static_assert(BIGINT_KARATSUBA_THRESHOLD >= 4, "Karatsuba needs at least 4 limbs to make its operands smaller");
 
-class bigint
-{
+/**
+ * @brief Operand size (in limbs) from which squaring switches from the schoolbook kernel to Karatsuba.
+ * Schoolbook squaring computes each cross product once, so it stays faster than schoolbook multiplication for longer.
+ */
+#ifndef BIGINT_SQR_KARATSUBA_THRESHOLD
+#define BIGINT_SQR_KARATSUBA_THRESHOLD 60
+#endif
+static_assert(BIGINT_SQR_KARATSUBA_THRESHOLD >= 4, "Karatsuba needs at least 4 limbs to make its operands smaller");
 
-public:
-    // ============================
-    //         Constructors
-    // ============================
+/**
+ * @brief Operand sizes (in limbs) from which multiplication switches from Karatsuba to Toom-3, and from Toom-3 to Toom-4.
+ */
+#ifndef BIGINT_TOOM3_THRESHOLD
+#define BIGINT_TOOM3_THRESHOLD 400
+#endif
+#ifndef BIGINT_TOOM4_THRESHOLD
+#define BIGINT_TOOM4_THRESHOLD 3000
+#endif
+static_assert(BIGINT_TOOM3_THRESHOLD >= 6 && BIGINT_TOOM4_THRESHOLD >= 8, "Toom-Cook needs enough limbs to make its operands smaller");
 
-    /**
-     * @brief Constructors for creating bigint objects from different types of inputs.
-     */
-    bigint();                    // Default constructor: initializes bigint to zero.
-    bigint(const int64_t &);     // Constructor for a integer input.
-    bigint(const std::string &); // Constructor for a string input.
-    bigint(const bigint &);      // Constructor for creating a new bigint by copying another one.
+/**
+ * @brief Operand size (in limbs) from which multiplication uses the number-theoretic transform.
+ */
+#ifndef BIGINT_FFT_THRESHOLD
+#define BIGINT_FFT_THRESHOLD 6000
+#endif
 
-    // ==================================
-    //         Operator Overloading
-    // ==================================
+/**
+ * @brief Number of limbs stored inside the bigint object itself. Values of at most this many limbs (256 bits with
+ * binary limbs) never allocate; longer values move to the heap.
+ */
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 4
+#endif
+static_assert(BIGINT_INLINE_LIMBS >= 1, "A bigint always holds at least one limb");
 
-    /**
-     * @name Assignment operators
-     * @brief Overloaded assignment operators for the bigint class.
-     *
-     */
-    bigint &operator=(const bigint &);      // Assign values to a bigint object from another bigint.
-    bigint &operator=(const int64_t &);     // Assign values to a bigint object from a 64-bit integer.
-    bigint &operator=(const std::string &); // Assign values to a bigint object from a a string.
+/**
+ * @brief Number of words (of 8 bytes) of scratch space that a thread keeps between two operations. The multiplication
+ * and division kernels take their temporary buffers from a per-thread stack, which is freed when a single operation
+ * made it grow past this size. The same bound applies to the powers of ten cached by the decimal conversions.
+ */
+#ifndef BIGINT_SCRATCH_KEEP
+#define BIGINT_SCRATCH_KEEP (size_t(1) << 20)
+#endif
 
-    /**
-     * @name Arithmetic and unary operators
-     * @brief Overloaded operators for arithmetic operations, increment/decrement, and unary operations.
-     *
-     * Including addition, subtraction ,multiplication, division, modulus,
-     * , increment, decrement, and unary operations.
-     */
-    // Addition
-    bigint &operator+=(const bigint &rhs);
-    friend bigint operator+(const bigint &lhs, const bigint &rhs); // Designed as a friend, it can be calculated in bigint and normal integers, such as bigint(1) + 2, although it is not needed
-    // Subtraction
-    bigint &operator-=(const bigint &rhs);
-    friend bigint operator-(const bigint &lhs, const bigint &rhs);
-    // Multiplication
-    bigint &operator*=(const bigint &rhs);
-    friend bigint operator*(const bigint &lhs, const bigint &rhs);
-    // Division
-    bigint &operator/=(const bigint &rhs);
-    friend bigint operator/(const bigint &lhs, const bigint &rhs);
-    // Modulus
-    bigint &operator%=(const bigint &);
-    friend bigint operator%(const bigint &, const bigint &);
-    // Increment and Decrement
-    bigint &operator++();         // Prefix increment (++a).
-    bigint &operator--();         // Prefix decrement (--a).
-    const bigint operator++(int); // Postfix increment (a++).
-    const bigint operator--(int); // Postfix decrement (a--).
-    // Unary
-    bigint &operator+();      // return itself
-    bigint operator-() const; // returns the negation.
+/**
+ * @brief Divisor and quotient size (in limbs) from which division switches from Knuth's long division to the
+ * recursive divide-and-conquer division.
+ */
+#ifndef BIGINT_DIV_DC_THRESHOLD
+#define BIGINT_DIV_DC_THRESHOLD 100
+#endif
+static_assert(BIGINT_DIV_DC_THRESHOLD >= 4, "The recursive division needs at least 4 limbs to split the divisor");
+
+/**
+ * @brief Length (in limbs, 19 decimal digits each) from which decimal strings are converted to binary limbs by
+ * divide and conquer instead of one 19-digit chunk at a time.
+ */
+#ifndef BIGINT_PARSE_DC_THRESHOLD
+#define BIGINT_PARSE_DC_THRESHOLD 40
+#endif
+static_assert(BIGINT_PARSE_DC_THRESHOLD >= 1, "The divide-and-conquer conversion needs at least one limb per piece");
 
+/**
+ * @brief Length (in limbs) from which binary limbs are converted to decimal digits by divide and conquer instead of
+ * one division by 10^19 per 19 digits.
+ */
+#ifndef BIGINT_PRINT_DC_THRESHOLD
+#define BIGINT_PRINT_DC_THRESHOLD 30
+#endif
+static_assert(BIGINT_PRINT_DC_THRESHOLD >= 8, "The divide-and-conquer conversion divides by powers of at least 2 limbs");
+
+/**
+ * @brief Vectorized kernels. On x86-64 with GCC or Clang, the addition, subtraction and comparison of limb arrays of
+ * at least BIGINT_SIMD_THRESHOLD limbs use AVX-512 or AVX2 when the CPU has them, chosen at run time with CPUID.
+ * Define BIGINT_NO_SIMD to keep only the portable kernels.
+ */
+#ifndef BIGINT_SIMD_THRESHOLD
+#define BIGINT_SIMD_THRESHOLD 16
+#endif
+#if !defined(BIGINT_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BIGINT_X86_SIMD
+#endif
+
+/**
+ * @brief Implementation details of bigint that do not depend on the limb radix.
+ */
+namespace bigint_detail
+{
     /**
-     * @name Comparison operators
-     * @brief Overloaded comparison operators for the bigint class. And return a boolean result.
-     *
+     * @brief The native integer types accepted directly by the bigint operators: integers of at most 64 bits, not bool.
      */
-    friend bool operator>(const bigint &lhs, const bigint &rhs);
-    friend bool operator==(const bigint &lhs, const bigint &rhs);
-    friend bool operator>=(const bigint &lhs, const bigint &rhs);
-    friend bool operator<(const bigint &lhs, const bigint &rhs);
-    friend bool operator<=(const bigint &lhs, const bigint &rhs);
-    friend bool operator!=(const bigint &lhs, const bigint &rhs);
+    template <typename T>
+    concept native_integer = std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t);
 
     /**
-     * @name Stream operators
-     * @brief Overloaded output stream for the bigint class.
-     *
+     * @brief Whether a native integer is negative (always false for unsigned types).
      */
-    friend std::ostream &operator<<(std::ostream &, const bigint &);
+    template <native_integer T>
+    constexpr bool is_negative(T v)
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            return v < 0;
+        }
+        else
+        {
+            return false;
+        }
+    }
 
     /**
-     * @brief Calculate the power of a bigint raised to another bigint or an integer exponent
+     * @brief The absolute value of a native integer as uint64_t, also for INT64_MIN.
      */
-    friend bigint pow(const bigint &, const bigint &);
+    template <native_integer T>
+    constexpr uint64_t magnitude(T v)
+    {
+        return is_negative(v) ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+    }
 
     /**
-     * @brief Returns the bigint value as a string.
+     * @brief Adds two words and a carry with the add-with-carry instruction (ADC on x86-64): through
+     * __builtin_addcll when the compiler has it, _addcarry_u64 on x86-64, otherwise a 128-bit sum.
      *
-     * @return Get the string representation of the bigint.
+     * @param carry The incoming carry (0 or 1), replaced by the outgoing carry.
+     * @return The low word of a + b + carry.
      */
-    std::string get_value() const;
+    inline uint64_t add_carry(uint64_t a, uint64_t b, uint64_t &carry)
+    {
+#if defined(BIGINT_HAS_BUILTIN_ADDC)
+        unsigned long long out;
+        const uint64_t sum = __builtin_addcll(a, b, carry, &out);
+        carry = out;
+        return sum;
+#elif defined(__x86_64__)
+        unsigned long long sum;
+        carry = _addcarry_u64(static_cast<unsigned char>(carry), a, b, &sum);
+        return sum;
+#else
+        __extension__ typedef unsigned __int128 uint128;
+        const uint128 sum = static_cast<uint128>(a) + b + carry;
+        carry = static_cast<uint64_t>(sum >> 64);
+        return static_cast<uint64_t>(sum);
+#endif
+    }
 
     /**
-     * @brief Checks if the bigint is positive.
+     * @brief Subtracts a word and a borrow from another word with the subtract-with-borrow instruction (SBB on
+     * x86-64), like add_carry.
      *
-     * @return if the bigint is positive return true, otherwise return false.
+     * @param borrow The incoming borrow (0 or 1), replaced by the outgoing borrow.
+     * @return a - b - borrow modulo 2^64.
      */
-    bool get_positive();
+    inline uint64_t sub_borrow(uint64_t a, uint64_t b, uint64_t &borrow)
+    {
+#if defined(BIGINT_HAS_BUILTIN_ADDC)
+        unsigned long long out;
+        const uint64_t diff = __builtin_subcll(a, b, borrow, &out);
+        borrow = out;
+        return diff;
+#elif defined(__x86_64__)
+        unsigned long long diff;
+        borrow = _subborrow_u64(static_cast<unsigned char>(borrow), a, b, &diff);
+        return diff;
+#else
+        const uint64_t diff = a - b - borrow;
+        borrow = (a < b || a - b < borrow) ? 1 : 0;
+        return diff;
+#endif
+    }
 
     /**
-     * @brief Returns the size of the vec.
+     * @brief Portable word-level kernels on binary limbs: r = a + b + carry and r = a - b - borrow over n words, with
+     * the ADC (SBB) chain unrolled four times so that the carry stays in the flags. r may be a or b.
      *
-     * @return The size of the vec.
+     * @return The carry (borrow) out of the last word.
      */
-    size_t get_vec_size() const
+    inline uint64_t add_words_scalar(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t carry)
     {
-        return vec.size();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            r[i] = add_carry(a[i], b[i], carry);
+            r[i + 1] = add_carry(a[i + 1], b[i + 1], carry);
+            r[i + 2] = add_carry(a[i + 2], b[i + 2], carry);
+            r[i + 3] = add_carry(a[i + 3], b[i + 3], carry);
+        }
+        for (; i < n; ++i)
+        {
+            r[i] = add_carry(a[i], b[i], carry);
+        }
+        return carry;
+    }
+    inline uint64_t sub_words_scalar(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t borrow)
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            r[i] = sub_borrow(a[i], b[i], borrow);
+            r[i + 1] = sub_borrow(a[i + 1], b[i + 1], borrow);
+            r[i + 2] = sub_borrow(a[i + 2], b[i + 2], borrow);
+            r[i + 3] = sub_borrow(a[i + 3], b[i + 3], borrow);
+        }
+        for (; i < n; ++i)
+        {
+            r[i] = sub_borrow(a[i], b[i], borrow);
+        }
+        return borrow;
     }
 
     /**
-     * @brief Remove any leading zeros from the stored digits
+     * @brief Compares two arrays of n words from the most significant one.
      *
+     * @return A negative value, 0 or a positive value if a is smaller, equal or bigger than b.
      */
-    void trim();
+    inline int cmp_words_scalar(const uint64_t *a, const uint64_t *b, size_t n)
+    {
+        while (n-- > 0)
+        {
+            if (a[n] != b[n])
+            {
+                return a[n] > b[n] ? 1 : -1;
+            }
+        }
+        return 0;
+    }
 
-private:
+#ifdef BIGINT_X86_SIMD
     /**
-     * @name Private members
-     * @brief These are private member variables and functions for internal use.
+     * @brief The vector instruction sets available on this CPU, detected once with CPUID.
      */
+    enum class simd_level
+    {
+        scalar,
+        avx2,
+        avx512
+    };
+    inline simd_level cpu_simd_level() noexcept
+    {
+        static const simd_level level = []
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return simd_level::avx512;
+            }
+            return __builtin_cpu_supports("avx2") ? simd_level::avx2 : simd_level::scalar;
+        }();
+        return level;
+    }
 
     /**
-     * @brief A vector to store the digits of the bigint.Each element of the vector represents a single decimal digit (0-9)
-     * stored as an 8-bit unsigned integer (uint8_t). In reverse order.
+     * @brief Vectorized addition: the words of a block are added lane by lane, then the carries between the lanes are
+     * resolved at once on bit masks. A lane generates a carry when its sum wrapped around (s < a), and propagates an
+     * incoming carry when its sum is all ones; with g and p the masks of these lanes and c the carry into the block,
+     * the lanes that receive a carry are ((g << 1 | c) + p) ^ p, and the bit above the block is the carry out.
+     * Subtraction is the same with borrows: a lane generates one when a < b and propagates one when a - b is zero.
      */
-    std::vector<uint8_t> vec;
+    __attribute__((target("avx512f"))) inline uint64_t add_words_avx512(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n)
+    {
+        const __m512i ones = _mm512_set1_epi64(-1);
+        unsigned carry = 0;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m512i x = _mm512_loadu_si512(a + i);
+            const __m512i s = _mm512_add_epi64(x, _mm512_loadu_si512(b + i));
+            const unsigned g = _mm512_cmplt_epu64_mask(s, x), p = _mm512_cmpeq_epu64_mask(s, ones);
+            const unsigned in = (((g << 1) | carry) + p) ^ p;
+            carry = in >> 8;
+            _mm512_storeu_si512(r + i, _mm512_mask_sub_epi64(s, static_cast<__mmask8>(in), s, ones)); // +1 in those lanes
+        }
+        return add_words_scalar(r + i, a + i, b + i, n - i, carry);
+    }
+    __attribute__((target("avx512f"))) inline uint64_t sub_words_avx512(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n)
+    {
+        const __m512i ones = _mm512_set1_epi64(-1);
+        unsigned borrow = 0;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m512i x = _mm512_loadu_si512(a + i), y = _mm512_loadu_si512(b + i);
+            const __m512i d = _mm512_sub_epi64(x, y);
+            const unsigned g = _mm512_cmplt_epu64_mask(x, y), p = _mm512_cmpeq_epu64_mask(d, _mm512_setzero_si512());
+            const unsigned in = (((g << 1) | borrow) + p) ^ p;
+            borrow = in >> 8;
+            _mm512_storeu_si512(r + i, _mm512_mask_add_epi64(d, static_cast<__mmask8>(in), d, ones)); // -1 in those lanes
+        }
+        return sub_words_scalar(r + i, a + i, b + i, n - i, borrow);
+    }
+    __attribute__((target("avx512f"))) inline int cmp_words_avx512(const uint64_t *a, const uint64_t *b, size_t n)
+    {
+        while (n >= 8) // Skips the equal blocks from the top, then compares the highest different word
+        {
+            n -= 8;
+            const unsigned ne = _mm512_cmpneq_epu64_mask(_mm512_loadu_si512(a + n), _mm512_loadu_si512(b + n));
+            if (ne != 0)
+            {
+                const size_t j = n + 31 - static_cast<size_t>(__builtin_clz(ne));
+                return a[j] > b[j] ? 1 : -1;
+            }
+        }
+        return cmp_words_scalar(a, b, n);
+    }
+
+    // AVX2 has no unsigned 64-bit comparison: flipping the sign bits turns it into the signed one
+    __attribute__((target("avx2"))) inline __m256i less_epu64_avx2(__m256i x, __m256i y)
+    {
+        const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(uint64_t(1) << 63));
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign));
+    }
+    // Expands the low four bits of a mask into four lanes of 0 or 1
+    __attribute__((target("avx2"))) inline __m256i mask_lanes_avx2(unsigned m)
+    {
+        return _mm256_and_si256(_mm256_srlv_epi64(_mm256_set1_epi64x(m), _mm256_setr_epi64x(0, 1, 2, 3)), _mm256_set1_epi64x(1));
+    }
+    __attribute__((target("avx2"))) inline unsigned lane_mask_avx2(__m256i v)
+    {
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+    }
+    __attribute__((target("avx2"))) inline uint64_t add_words_avx2(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n)
+    {
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        unsigned carry = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            const __m256i s = _mm256_add_epi64(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+            const unsigned g = lane_mask_avx2(less_epu64_avx2(s, x)), p = lane_mask_avx2(_mm256_cmpeq_epi64(s, ones));
+            const unsigned in = (((g << 1) | carry) + p) ^ p;
+            carry = in >> 4;
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), _mm256_add_epi64(s, mask_lanes_avx2(in)));
+        }
+        return add_words_scalar(r + i, a + i, b + i, n - i, carry);
+    }
+    __attribute__((target("avx2"))) inline uint64_t sub_words_avx2(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n)
+    {
+        unsigned borrow = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            const __m256i d = _mm256_sub_epi64(x, y);
+            const unsigned g = lane_mask_avx2(less_epu64_avx2(x, y)), p = lane_mask_avx2(_mm256_cmpeq_epi64(d, _mm256_setzero_si256()));
+            const unsigned in = (((g << 1) | borrow) + p) ^ p;
+            borrow = in >> 4;
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), _mm256_sub_epi64(d, mask_lanes_avx2(in)));
+        }
+        return sub_words_scalar(r + i, a + i, b + i, n - i, borrow);
+    }
+    __attribute__((target("avx2"))) inline int cmp_words_avx2(const uint64_t *a, const uint64_t *b, size_t n)
+    {
+        while (n >= 4)
+        {
+            n -= 4;
+            const __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + n)),
+                                                  _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + n)));
+            const unsigned ne = lane_mask_avx2(eq) ^ 0xF;
+            if (ne != 0)
+            {
+                const size_t j = n + 31 - static_cast<size_t>(__builtin_clz(ne));
+                return a[j] > b[j] ? 1 : -1;
+            }
+        }
+        return cmp_words_scalar(a, b, n);
+    }
+#endif
 
     /**
-     * @brief Initializes constexpr static member variables. These members representing zero, one, two, and ten respectively
+     * @brief The word-level kernels used by bigint: the vectorized ones for long arrays when the CPU has them,
+     * otherwise the portable ones.
      */
-    static const bigint s_zero;
-    static const bigint s_one;
-    static const bigint s_two;
-    static const bigint s_ten;
+    inline uint64_t add_words(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n)
+    {
+#ifdef BIGINT_X86_SIMD
+        if (n >= BIGINT_SIMD_THRESHOLD)
+        {
+            switch (cpu_simd_level())
+            {
+            case simd_level::avx512:
+                return add_words_avx512(r, a, b, n);
+            case simd_level::avx2:
+                return add_words_avx2(r, a, b, n);
+            default:
+                break;
+            }
+        }
+#endif
+        return add_words_scalar(r, a, b, n, 0);
+    }
+    inline uint64_t sub_words(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n)
+    {
+#ifdef BIGINT_X86_SIMD
+        if (n >= BIGINT_SIMD_THRESHOLD)
+        {
+            switch (cpu_simd_level())
+            {
+            case simd_level::avx512:
+                return sub_words_avx512(r, a, b, n);
+            case simd_level::avx2:
+                return sub_words_avx2(r, a, b, n);
+            default:
+                break;
+            }
+        }
+#endif
+        return sub_words_scalar(r, a, b, n, 0);
+    }
+    inline int cmp_words(const uint64_t *a, const uint64_t *b, size_t n)
+    {
+#ifdef BIGINT_X86_SIMD
+        if (n >= BIGINT_SIMD_THRESHOLD)
+        {
+            switch (cpu_simd_level())
+            {
+            case simd_level::avx512:
+                return cmp_words_avx512(a, b, n);
+            case simd_level::avx2:
+                return cmp_words_avx2(a, b, n);
+            default:
+                break;
+            }
+        }
+#endif
+        return cmp_words_scalar(a, b, n);
+    }
 
     /**
-     * @brief Represent the bigint wether is positive.
+     * @brief A vector of trivially copyable values whose first N elements are stored inline, in the object itself.
+     *
+     * It only allocates when it grows past N elements, and then behaves like std::vector (amortized doubling,
+     * clear() and shrinking keep the capacity). data() always points to the current storage, so element access
+     * does not branch on where the elements live. A moved-from vector is empty.
+     *
+     * Heap buffers come from Alloc. A copy takes the allocator given by select_on_container_copy_construction, like
+     * the standard containers (the default memory resource for a polymorphic_allocator), and a move keeps the
+     * allocator of its source. Assignments and swaps follow the propagate_on_container_* traits of Alloc, and copy
+     * the elements when the buffer cannot change hands between two unequal allocators.
      */
-    bool is_Positive;
-};
+    template <typename T, size_t N, typename Alloc = std::allocator<T>>
+    class small_vector
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "small_vector copies its elements with std::copy");
+        static_assert(std::is_same_v<typename std::allocator_traits<Alloc>::value_type, T>, "Alloc must allocate T");
+        using traits = std::allocator_traits<Alloc>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        // Whether the heap buffers can always change hands, so that moves and swaps never copy elements
+        static constexpr bool nothrow_swap = traits::propagate_on_container_swap::value || traits::is_always_equal::value;
+        static constexpr bool nothrow_move_assign = traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value;
+
+        small_vector() noexcept : ptr(buf) {}
+        explicit small_vector(const Alloc &a) noexcept : ptr(buf), alloc(a) {}
+        small_vector(size_t n, const T &value, const Alloc &a = Alloc()) : small_vector(a) { assign(n, value); }
+        small_vector(const small_vector &other) : small_vector(traits::select_on_container_copy_construction(other.alloc))
+        {
+            assign(other.begin(), other.end());
+        }
+        small_vector(const small_vector &other, const Alloc &a) : small_vector(a) { assign(other.begin(), other.end()); }
+        small_vector(small_vector &&other) noexcept : ptr(buf), alloc(other.alloc) { take(other); }
+        small_vector(small_vector &&other, const Alloc &a) : small_vector(a)
+        {
+            if (alloc == other.alloc)
+            {
+                take(other);
+            }
+            else
+            {
+                assign(other.begin(), other.end());
+            }
+        }
+        ~small_vector() { release(); }
+
+        small_vector &operator=(const small_vector &other)
+        {
+            if (this != &other)
+            {
+                if constexpr (traits::propagate_on_container_copy_assignment::value)
+                {
+                    if (alloc != other.alloc)
+                    {
+                        release(); // The buffer belongs to the old allocator
+                    }
+                    alloc = other.alloc;
+                }
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+        small_vector &operator=(small_vector &&other) noexcept(nothrow_move_assign)
+        {
+            if (this != &other)
+            {
+                if (traits::propagate_on_container_move_assignment::value || alloc == other.alloc)
+                {
+                    release();
+                    if constexpr (traits::propagate_on_container_move_assignment::value)
+                    {
+                        alloc = other.alloc;
+                    }
+                    take(other);
+                }
+                else
+                {
+                    assign(other.begin(), other.end()); // This allocator cannot free the buffer of other
+                }
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept { return alloc; }
+        size_t size() const noexcept { return len; }
+        size_t capacity() const noexcept { return cap; }
+        bool empty() const noexcept { return len == 0; }
+        T *data() noexcept { return ptr; }
+        const T *data() const noexcept { return ptr; }
+        T &operator[](size_t i) noexcept { return ptr[i]; }
+        const T &operator[](size_t i) const noexcept { return ptr[i]; }
+        T &back() noexcept { return ptr[len - 1]; }
+        const T &back() const noexcept { return ptr[len - 1]; }
+        iterator begin() noexcept { return ptr; }
+        iterator end() noexcept { return ptr + len; }
+        const_iterator begin() const noexcept { return ptr; }
+        const_iterator end() const noexcept { return ptr + len; }
+
+        void clear() noexcept { len = 0; }
+        void pop_back() noexcept { --len; }
+        void push_back(const T &value)
+        {
+            if (len == cap)
+            {
+                T copy = value; // value may live in the buffer that is about to be released
+                grow(len + 1);
+                ptr[len++] = copy;
+                return;
+            }
+            ptr[len++] = value;
+        }
+        void reserve(size_t n)
+        {
+            if (n > cap)
+            {
+                reallocate(n, len);
+            }
+        }
+        void resize(size_t n, const T &value = T())
+        {
+            if (n > cap)
+            {
+                grow(n);
+            }
+            if (n > len)
+            {
+                std::fill(ptr + len, ptr + n, value);
+            }
+            len = n;
+        }
+        void assign(size_t n, const T &value)
+        {
+            if (n > cap)
+            {
+                reallocate(n, 0); // The old elements are overwritten, no need to keep them
+            }
+            std::fill(ptr, ptr + n, value);
+            len = n;
+        }
+        template <typename It>
+        void assign(It first, It last)
+        {
+            const size_t n = static_cast<size_t>(std::distance(first, last));
+            if (n > cap)
+            {
+                T *p = traits::allocate(alloc, n); // The range may be inside this vector, copy it before releasing the buffer
+                std::copy(first, last, p);
+                release();
+                ptr = p;
+                cap = n;
+            }
+            else
+            {
+                std::copy(first, last, ptr);
+            }
+            len = n;
+        }
+        iterator insert(const_iterator pos, size_t n, const T &value)
+        {
+            const size_t at = static_cast<size_t>(pos - ptr);
+            const size_t old = len;
+            resize(len + n);
+            std::copy_backward(ptr + at, ptr + old, ptr + len);
+            std::fill(ptr + at, ptr + at + n, value);
+            return ptr + at;
+        }
+
+        void swap(small_vector &other) noexcept(nothrow_swap)
+        {
+            if constexpr (traits::propagate_on_container_swap::value)
+            {
+                using std::swap;
+                swap(alloc, other.alloc);
+            }
+            else if (alloc != other.alloc)
+            {
+                // Each buffer must stay with its allocator: copy the elements across instead
+                small_vector mine(other, alloc), theirs(*this, other.alloc);
+                swap_storage(mine);
+                other.swap_storage(theirs);
+                return;
+            }
+            swap_storage(other);
+        }
+
+    private:
+        T *ptr;         // buf, or a heap buffer of cap elements
+        size_t len = 0;
+        size_t cap = N;
+        [[no_unique_address]] Alloc alloc = Alloc();
+        T buf[N];
+
+        bool is_inline() const noexcept { return ptr == buf; }
+
+        // Moves to a buffer of at least n elements, doubling so that push_back is amortized O(1)
+        void grow(size_t n) { reallocate(std::max(n, 2 * cap), len); }
+
+        // Moves the first keep elements to a new heap buffer of n elements
+        void reallocate(size_t n, size_t keep)
+        {
+            T *p = traits::allocate(alloc, n);
+            std::copy(ptr, ptr + keep, p);
+            release();
+            ptr = p;
+            cap = n;
+        }
+
+        // Frees the heap buffer, if any, and goes back to the inline buffer (the elements are not kept)
+        void release() noexcept
+        {
+            if (!is_inline())
+            {
+                traits::deallocate(alloc, ptr, cap);
+                ptr = buf;
+                cap = N;
+            }
+        }
+
+        // Takes the elements of other, which must be inline and empty in this; other is left empty
+        void take(small_vector &other) noexcept
+        {
+            if (other.is_inline())
+            {
+                std::copy(other.buf, other.buf + other.len, buf);
+            }
+            else
+            {
+                ptr = other.ptr;
+                cap = other.cap;
+                other.ptr = other.buf;
+                other.cap = N;
+            }
+            len = other.len;
+            other.len = 0;
+        }
+
+        // Exchanges the elements with other, whose buffer this allocator can free (no allocation)
+        void swap_storage(small_vector &other) noexcept
+        {
+            if (!is_inline() && !other.is_inline())
+            {
+                std::swap(ptr, other.ptr);
+                std::swap(len, other.len);
+                std::swap(cap, other.cap);
+                return;
+            }
+            if (is_inline() && other.is_inline())
+            {
+                T tmp[N];
+                std::copy(buf, buf + len, tmp);
+                std::copy(other.buf, other.buf + other.len, buf);
+                std::copy(tmp, tmp + len, other.buf);
+                std::swap(len, other.len);
+                return;
+            }
+            // One of them is inline: its elements move to the inline buffer of the other, which gives up its heap buffer
+            small_vector &heap = is_inline() ? other : *this;
+            small_vector &in = is_inline() ? *this : other;
+            T *p = heap.ptr;
+            const size_t heap_len = heap.len, heap_cap = heap.cap;
+            std::copy(in.buf, in.buf + in.len, heap.buf);
+            heap.ptr = heap.buf;
+            heap.len = in.len;
+            heap.cap = N;
+            in.ptr = p;
+            in.len = heap_len;
+            in.cap = heap_cap;
+        }
+    };
+
+    /**
+     * @brief A per-thread stack of words for the temporary limb buffers of the multiplication and division kernels.
+     *
+     * Buffers are taken through a scratch_frame, which gives all of them back when it goes out of scope, so they are
+     * released in last-in first-out order like the recursion that uses them. The blocks of words are kept for the
+     * next operations: once the stack has grown to the needs of the largest operation, the kernels do not allocate
+     * anymore. When the outermost frame ends with more than BIGINT_SCRATCH_KEEP words in the blocks, they are
+     * freed, so that one huge operation does not pin its scratch space for the lifetime of the thread.
+     */
+    class scratch_stack
+    {
+    public:
+        static scratch_stack &local() noexcept
+        {
+            thread_local scratch_stack stack;
+            return stack;
+        }
+
+    private:
+        friend class scratch_frame;
+
+        struct block
+        {
+            std::unique_ptr<uint64_t[]> words;
+            size_t size;
+        };
+        std::vector<block> blocks;
+        size_t current = 0;  // Index of the block in use
+        size_t top = 0;      // Words taken from the current block
+        size_t depth = 0;    // Number of live frames
+        size_t capacity = 0; // Words in all blocks
+
+        // Makes sure that the next n words can be taken from the current block, moving to another block if needed
+        void reserve(size_t n)
+        {
+            while (current < blocks.size() && blocks[current].size - top < n)
+            {
+                ++current; // The rest of the block stays unused until the frame that moved past it ends
+                top = 0;
+            }
+            if (current == blocks.size())
+            {
+                const size_t size = std::max(n, blocks.empty() ? size_t(4096) : 2 * blocks.back().size);
+                blocks.push_back({std::make_unique_for_overwrite<uint64_t[]>(size), size});
+                capacity += size;
+            }
+        }
+
+        uint64_t *take(size_t n)
+        {
+            reserve(n);
+            uint64_t *p = blocks[current].words.get() + top;
+            top += n;
+            return p;
+        }
+
+        void restore(size_t block_index, size_t offset) noexcept
+        {
+            current = block_index;
+            top = offset;
+            if (--depth == 0 && capacity > BIGINT_SCRATCH_KEEP)
+            {
+                blocks.clear();
+                capacity = 0;
+            }
+        }
+    };
+
+    /**
+     * @brief A scope in the scratch stack of the current thread. The buffers taken through it are valid until it is
+     * destroyed, they are not initialized.
+     */
+    class scratch_frame
+    {
+    public:
+        scratch_frame() noexcept : stack(scratch_stack::local()), block_index(stack.current), offset(stack.top)
+        {
+            ++stack.depth;
+        }
+        ~scratch_frame() { stack.restore(block_index, offset); }
+        scratch_frame(const scratch_frame &) = delete;
+        scratch_frame &operator=(const scratch_frame &) = delete;
+
+        uint64_t *take(size_t n) { return stack.take(n); }  // n uninitialized words
+        void reserve(size_t n) { stack.reserve(n); }         // The next n words taken are contiguous in one block
+
+    private:
+        scratch_stack &stack;
+        size_t block_index, offset;
+    };
+
+    /**
+     * @brief Computes base^e mod m at compile time, for m < 2^32.
+     */
+    constexpr uint64_t pow_mod(uint64_t base, uint64_t e, uint64_t m)
+    {
+        uint64_t ret = 1;
+        for (base %= m; e > 0; e >>= 1, base = base * base % m)
+        {
+            if (e & 1)
+            {
+                ret = ret * base % m;
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Arithmetic modulo an NTT prime Mod = c * 2^k + 1 < 2^31, whose primitive root is Root.
+     *
+     * Values inside the transform are kept in Montgomery form (x * 2^32 mod Mod), so that a modular multiplication
+     * is two 32x32-bit multiplications and a shift instead of a 64-bit division.
+     */
+    template <uint32_t Mod, uint32_t Root>
+    struct ntt_prime
+    {
+        static constexpr uint32_t mod = Mod;
+
+        // -Mod^-1 mod 2^32, by Newton iteration (each step doubles the number of correct bits)
+        static constexpr uint32_t neg_inv = []
+        {
+            uint32_t inv = Mod;
+            for (int i = 0; i < 5; ++i)
+            {
+                inv *= 2 - Mod * inv;
+            }
+            return static_cast<uint32_t>(0 - inv);
+        }();
+
+        // 2^64 mod Mod, used to enter the Montgomery form
+        static constexpr uint32_t r2 = static_cast<uint32_t>(pow_mod(2, 64, Mod));
+
+        // The conditional subtractions are written as unsigned minimums (a wrapped-around value is huge),
+        // which compile without branches and let the butterfly loops vectorize.
+        static uint32_t reduce(uint64_t t) // t * 2^-32 mod Mod, for t < Mod * 2^32
+        {
+            uint32_t m = static_cast<uint32_t>(t) * neg_inv;
+            uint32_t u = static_cast<uint32_t>((t + static_cast<uint64_t>(m) * Mod) >> 32);
+            return std::min(u, u - Mod);
+        }
+        static uint32_t mul(uint32_t a, uint32_t b) { return reduce(static_cast<uint64_t>(a) * b); }
+        static uint32_t add(uint32_t a, uint32_t b) { return std::min(a + b, a + b - Mod); }
+        static uint32_t sub(uint32_t a, uint32_t b) { return std::min(a - b, a - b + Mod); }
+        static uint32_t to_mont(uint32_t a) { return mul(a % Mod, r2); }
+        static uint32_t from_mont(uint32_t a) { return reduce(a); }
+        static uint32_t power(uint32_t base, uint64_t e) // base in Montgomery form
+        {
+            uint32_t ret = to_mont(1);
+            for (; e > 0; e >>= 1, base = mul(base, base))
+            {
+                if (e & 1)
+                {
+                    ret = mul(ret, base);
+                }
+            }
+            return ret;
+        }
+
+        /**
+         * @brief In-place iterative radix-2 transform of a power-of-two length, in Montgomery form.
+         *
+         * The forward transform is decimation in frequency: it takes the values in natural order and leaves the
+         * result in bit-reversed order. The inverse transform is decimation in time: it takes bit-reversed values and
+         * returns them in natural order. Pointwise products do not care about the order, so no bit-reversal pass is needed.
+         * The inverse transform does not divide by the length, convolve() folds that into the pointwise products.
+         *
+         * @param a The values to transform.
+         * @param invert Computes the inverse transform when true.
+         */
+        static void transform(std::vector<uint32_t> &a, bool invert)
+        {
+            const size_t n = a.size();
+            if (n < 2)
+            {
+                return;
+            }
+
+            // roots[half + j] = w_len^j for every level len = 2 * half, where w_len is a primitive len-th root of unity
+            // (or its inverse), so that each level reads its roots contiguously
+            std::vector<uint32_t> roots(n);
+            uint32_t w = power(to_mont(Root), (Mod - 1) / n);
+            if (invert)
+            {
+                w = power(w, n - 1);
+            }
+            roots[n / 2] = to_mont(1);
+            for (size_t j = n / 2 + 1; j < n; ++j)
+            {
+                roots[j] = mul(roots[j - 1], w);
+            }
+            for (size_t j = n / 2; j-- > 1;)
+            {
+                roots[j] = roots[2 * j];
+            }
+
+            if (!invert)
+            {
+                for (size_t half = n / 2; half > 0; half >>= 1) // Gentleman-Sande butterflies, from the longest blocks
+                {
+                    const uint32_t *level = roots.data() + half;
+                    for (size_t i = 0; i < n; i += 2 * half)
+                    {
+                        for (size_t j = 0; j < half; ++j)
+                        {
+                            uint32_t u = a[i + j], v = a[i + j + half];
+                            a[i + j] = add(u, v);
+                            a[i + j + half] = mul(sub(u, v), level[j]);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for (size_t half = 1; half < n; half <<= 1) // Cooley-Tukey butterflies, from the shortest blocks
+                {
+                    const uint32_t *level = roots.data() + half;
+                    for (size_t i = 0; i < n; i += 2 * half)
+                    {
+                        for (size_t j = 0; j < half; ++j)
+                        {
+                            uint32_t u = a[i + j], v = mul(a[i + j + half], level[j]);
+                            a[i + j] = add(u, v);
+                            a[i + j + half] = sub(u, v);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Cyclic convolution of two digit sequences modulo Mod.
+         * When a and b are the same sequence, it is transformed only once (a square).
+         *
+         * @param a The first sequence, as plain digits.
+         * @param b The second sequence, as plain digits.
+         * @param n The transform length, a power of two at least a.size() + b.size() - 1.
+         * @return The residues of the convolution, as plain numbers in [0, Mod).
+         */
+        static std::vector<uint32_t> convolve(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b, size_t n)
+        {
+            const bool square = (&a == &b);
+            std::vector<uint32_t> fa(n, 0), fb;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                fa[i] = to_mont(a[i]);
+            }
+            transform(fa, false);
+            if (!square)
+            {
+                fb.assign(n, 0);
+                for (size_t i = 0; i < b.size(); ++i)
+                {
+                    fb[i] = to_mont(b[i]);
+                }
+                transform(fb, false);
+            }
+            const std::vector<uint32_t> &fc = square ? fa : fb;
+            const uint32_t n_inv = power(to_mont(static_cast<uint32_t>(n % Mod)), Mod - 2); // Scaling of the inverse transform
+            for (size_t i = 0; i < n; ++i)
+            {
+                fa[i] = mul(mul(fa[i], fc[i]), n_inv);
+            }
+            transform(fa, true);
+            for (uint32_t &x : fa)
+            {
+                x = from_mont(x);
+            }
+            return fa;
+        }
+    };
+
+    /**
+     * @brief The three NTT primes. Their product (about 2^86.7) bounds the convolution coefficients that can be recovered
+     * by the Chinese remainder theorem, and the smallest 2-adic order (2^25) bounds the transform length.
+     */
+    using ntt_prime_1 = ntt_prime<2013265921U, 31U>; // 15 * 2^27 + 1
+    using ntt_prime_2 = ntt_prime<469762049U, 3U>;   // 7 * 2^26 + 1
+    using ntt_prime_3 = ntt_prime<167772161U, 3U>;   // 5 * 2^25 + 1
+    constexpr size_t ntt_max_length = size_t(1) << 25;
+
+    /**
+     * @brief Digits of the bases 2 to 36, and the value of a digit character (36 for a character that is no digit).
+     * Letters are read in both cases and written in lowercase, as by std::to_chars and std::from_chars.
+     */
+    constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    constexpr unsigned digit_value(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return static_cast<unsigned>(c - '0');
+        }
+        if (c >= 'a' && c <= 'z')
+        {
+            return static_cast<unsigned>(c - 'a') + 10;
+        }
+        if (c >= 'A' && c <= 'Z')
+        {
+            return static_cast<unsigned>(c - 'A') + 10;
+        }
+        return 36;
+    }
+
+    /**
+     * @brief Checks that a base is between 2 and 36.
+     *
+     * @throws std::invalid_argument If it is not.
+     */
+    inline void check_base(int base)
+    {
+        if (base < 2 || base > 36)
+        {
+            throw std::invalid_argument("Base must be between 2 and 36");
+        }
+    }
+}
+
+/**
+ * @brief Opt-in expression templates over the bigint operators, defined at the end of this file.
+ */
+namespace bigint_expr
+{
+    struct access;
+
+    /**
+     * @brief A lazy expression whose value is a B, built by the operators of bigint_expr.
+     */
+    template <typename E, typename B>
+    concept expression_of = std::remove_cvref_t<E>::is_bigint_expression && std::same_as<typename std::remove_cvref_t<E>::value_type, B>;
+}
+
+/**
+ * @class basic_bigint
+ * @brief A class template for handling big integers
+ *
+ * This class provides operations for big integers, including initialization, addition, subtraction, multiplication, division,
+ * modulus, and comparison operations.
+ *
+ * @tparam Radix The base of one limb. 0 stands for 2^64 (binary limbs, the fastest arithmetic), a power of ten such as
+ * 10^9 or 10^18 selects decimal limbs, where get_value() and operator<< are linear in the number of digits.
+ * @tparam Alloc The allocator of the limbs (of uint64_t) that do not fit inline, for example a
+ * std::pmr::polymorphic_allocator backed by an arena. Results of the operators use the allocator of their left operand.
+ */
+template <uint64_t Radix = 0, typename Alloc = std::allocator<uint64_t>>
+class basic_bigint
+{
+
+public:
+    using allocator_type = Alloc;
+
+    /**
+     * @brief Whether move assignment and swap never throw: true unless Alloc may hold unequal allocators that do not
+     * propagate, between which the limbs have to be copied.
+     */
+    static constexpr bool nothrow_swap = bigint_detail::small_vector<uint64_t, BIGINT_INLINE_LIMBS, Alloc>::nothrow_swap;
+
+    // ============================
+    //         Constructors
+    // ============================
+
+    /**
+     * @brief Constructors for creating bigint objects from different types of inputs.
+     */
+    basic_bigint();                     // Default constructor: initializes bigint to zero.
+    basic_bigint(const int64_t &);      // Constructor for a integer input.
+    basic_bigint(const std::string &);  // Constructor for a string input.
+    basic_bigint(const std::string &, int base); // Constructor for a string of digits in base 2 to 36.
+    basic_bigint(const basic_bigint &); // Constructor for creating a new bigint by copying another one.
+    basic_bigint(basic_bigint &&) noexcept; // Constructor taking over the limbs of a temporary bigint.
+
+    /**
+     * @brief Allocator-extended constructors: the same as above, with the limbs allocated by alloc.
+     */
+    explicit basic_bigint(const Alloc &alloc);
+    basic_bigint(const int64_t &, const Alloc &alloc);
+    basic_bigint(const std::string &, const Alloc &alloc);
+    basic_bigint(const std::string &, int base, const Alloc &alloc);
+    basic_bigint(const basic_bigint &, const Alloc &alloc);
+    basic_bigint(basic_bigint &&, const Alloc &alloc);
+
+    /**
+     * @brief Constructors evaluating a lazy expression of bigint_expr, such as lazy(a) * b + c.
+     */
+    template <bigint_expr::expression_of<basic_bigint> E>
+    basic_bigint(const E &expr);
+    template <bigint_expr::expression_of<basic_bigint> E>
+    basic_bigint(const E &expr, const Alloc &alloc);
+
+    /**
+     * @brief Returns the allocator of the limbs.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return vec.get_allocator();
+    }
+
+    // ==================================
+    //         Operator Overloading
+    // ==================================
+
+    /**
+     * @name Assignment operators
+     * @brief Overloaded assignment operators for the bigint class.
+     *
+     */
+    basic_bigint &operator=(const basic_bigint &); // Assign values to a bigint object from another bigint.
+    basic_bigint &operator=(basic_bigint &&) noexcept(nothrow_swap); // Take over the limbs of a temporary bigint.
+    basic_bigint &operator=(const int64_t &);      // Assign values to a bigint object from a 64-bit integer.
+    basic_bigint &operator=(const std::string &);  // Assign values to a bigint object from a a string.
+    template <bigint_expr::expression_of<basic_bigint> E>
+    basic_bigint &operator=(const E &expr);        // Evaluate a lazy expression into this bigint, reusing its limbs.
+
+    /**
+     * @brief Exchanges the values of two bigints by swapping their limb buffers, without copying any limb
+     * (unless their allocators differ and do not propagate on swap).
+     *
+     * @param other The other bigint.
+     */
+    void swap(basic_bigint &other) noexcept(nothrow_swap);
+    friend void swap(basic_bigint &lhs, basic_bigint &rhs) noexcept(nothrow_swap)
+    {
+        lhs.swap(rhs);
+    }
+
+    /**
+     * @name Arithmetic and unary operators
+     * @brief Overloaded operators for arithmetic operations, increment/decrement, and unary operations.
+     *
+     * Including addition, subtraction ,multiplication, division, modulus,
+     * , increment, decrement, and unary operations.
+     * The binary operators are friends defined in the class (found by argument-dependent lookup), so they can be
+     * calculated in bigint and normal integers, such as bigint(1) + 2.
+     */
+    // Addition
+    basic_bigint &operator+=(const basic_bigint &rhs);
+    // Subtraction
+    basic_bigint &operator-=(const basic_bigint &rhs);
+    // Multiplication
+    basic_bigint &operator*=(const basic_bigint &rhs);
+    // Division
+    basic_bigint &operator/=(const basic_bigint &rhs);
+    // Modulus
+    basic_bigint &operator%=(const basic_bigint &);
+    // With a native integer, in O(n) with single-limb kernels and without building a temporary bigint
+    template <bigint_detail::native_integer T>
+    basic_bigint &operator+=(T rhs);
+    template <bigint_detail::native_integer T>
+    basic_bigint &operator-=(T rhs);
+    template <bigint_detail::native_integer T>
+    basic_bigint &operator*=(T rhs);
+    template <bigint_detail::native_integer T>
+    basic_bigint &operator/=(T rhs);
+    template <bigint_detail::native_integer T>
+    basic_bigint &operator%=(T rhs);
+    // With a lazy expression, added in place: x += lazy(a) * b is a fused multiply-add
+    template <bigint_expr::expression_of<basic_bigint> E>
+    basic_bigint &operator+=(const E &expr);
+    template <bigint_expr::expression_of<basic_bigint> E>
+    basic_bigint &operator-=(const E &expr);
+    // Increment and Decrement
+    basic_bigint &operator++();         // Prefix increment (++a).
+    basic_bigint &operator--();         // Prefix decrement (--a).
+    basic_bigint operator++(int);       // Postfix increment (a++).
+    basic_bigint operator--(int);       // Postfix decrement (a--).
+    // Unary
+    basic_bigint &operator+();         // return itself
+    basic_bigint operator-() const &;  // returns the negation.
+    basic_bigint operator-() &&;       // returns the negation, in the limbs of the temporary.
+
+    /**
+     * @brief Overloads the + operator for bigint addition.
+     *
+     * @param lhs The first bigint.
+     * @param rhs The second bigint.
+     * @return The result of adding lhs and rhs.
+     */
+    friend basic_bigint operator+(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        basic_bigint ret(lhs, lhs.get_allocator());
+        ret += rhs; // Reuse the += operator.
+        return ret;
+    }
+
+    /**
+     * @brief Overloads the - operator for bigint subtraction.
+     *
+     * @param lhs The first bigint.
+     * @param rhs The subtrahend bigint.
+     * @return The result of subtracting rhs from lhs.
+     */
+    friend basic_bigint operator-(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+
+        basic_bigint ret(lhs, lhs.get_allocator());
+        ret -= rhs; // Reuse the -= operator.
+        return ret;
+    }
+
+    /**
+     * @brief Overloads the * operator for bigint multiplication.
+     *
+     * @param lhs The first bigint(multiplicand).
+     * @param rhs The second bigint(multiplier).
+     * @return The result of multiplying lhs by rhs.
+     */
+    friend basic_bigint operator*(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        return basic_bigint::mul_signed(lhs, rhs); // The product goes straight into the result, lhs is not copied
+    }
+
+    /**
+     * @brief Overloads the / operator for bigint division.
+     *
+     *
+     * @param lhs The dividend bigint.
+     * @param rhs The divisor bigint.
+     * @return The quotient of dividing lhs by rhs.
+     */
+    friend basic_bigint operator/(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        basic_bigint quotient(lhs.get_allocator()), remainder(lhs.get_allocator());
+        divmod(lhs, rhs, quotient, remainder);
+        return quotient;
+    }
+
+    /**
+     * @brief Overloads the % operator for bigint modulus.
+     *
+     * @param lhs The dividend bigint.
+     * @param rhs The divisor bigint.
+     * @return The remainder of dividing lhs by rhs.
+     */
+    friend basic_bigint operator%(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        basic_bigint quotient(lhs.get_allocator()), remainder(lhs.get_allocator());
+        divmod(lhs, rhs, quotient, remainder);
+        return remainder;
+    }
+
+    /**
+     * @name Arithmetic operators with temporaries
+     * @brief Overloads taking an rvalue operand (the result of another operator, or std::move(x)). The result is
+     * computed in the limbs of the temporary and moved out, so a chain such as a + b + c + d works in one buffer
+     * instead of copying every intermediate result. A right-hand temporary is only reused when its allocator is
+     * equal to the one of lhs (always for std::allocator), so that the result keeps the allocator of lhs.
+     */
+    friend basic_bigint operator+(basic_bigint &&lhs, const basic_bigint &rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+    friend basic_bigint operator+(const basic_bigint &lhs, basic_bigint &&rhs)
+    {
+        if (rhs.get_allocator() != lhs.get_allocator()) // The result must use the allocator of lhs
+        {
+            return lhs + static_cast<const basic_bigint &>(rhs);
+        }
+        rhs += lhs; // Addition commutes
+        return std::move(rhs);
+    }
+    friend basic_bigint operator+(basic_bigint &&lhs, basic_bigint &&rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+    friend basic_bigint operator-(basic_bigint &&lhs, const basic_bigint &rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+    friend basic_bigint operator-(const basic_bigint &lhs, basic_bigint &&rhs)
+    {
+        if (rhs.get_allocator() != lhs.get_allocator()) // The result must use the allocator of lhs
+        {
+            return lhs - static_cast<const basic_bigint &>(rhs);
+        }
+        rhs -= lhs; // lhs - rhs = -(rhs - lhs)
+        return -std::move(rhs);
+    }
+    friend basic_bigint operator-(basic_bigint &&lhs, basic_bigint &&rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+    friend basic_bigint operator*(basic_bigint &&lhs, const basic_bigint &rhs)
+    {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+    friend basic_bigint operator*(const basic_bigint &lhs, basic_bigint &&rhs)
+    {
+        if (rhs.get_allocator() != lhs.get_allocator()) // The result must use the allocator of lhs
+        {
+            return lhs * static_cast<const basic_bigint &>(rhs);
+        }
+        rhs *= lhs; // Multiplication commutes
+        return std::move(rhs);
+    }
+    friend basic_bigint operator*(basic_bigint &&lhs, basic_bigint &&rhs)
+    {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+    friend basic_bigint operator/(basic_bigint &&lhs, const basic_bigint &rhs)
+    {
+        basic_bigint remainder(lhs.get_allocator());
+        divmod(lhs, rhs, lhs, remainder); // The quotient reuses the limbs of the dividend
+        return std::move(lhs);
+    }
+    friend basic_bigint operator%(basic_bigint &&lhs, const basic_bigint &rhs)
+    {
+        basic_bigint quotient(lhs.get_allocator());
+        divmod(lhs, rhs, quotient, lhs); // The remainder reuses the limbs of the dividend
+        return std::move(lhs);
+    }
+
+    /**
+     * @brief Computes the quotient and the remainder of a division at once, into existing bigints.
+     *
+     * The quotient is truncated toward zero and the remainder has the sign of the dividend, like / and %:
+     * lhs = quotient * rhs + remainder. The results may be the operands themselves, e.g. divmod(a, b, a, b).
+     *
+     * @param lhs The dividend bigint.
+     * @param rhs The divisor bigint.
+     * @param quotient Receives lhs / rhs.
+     * @param remainder Receives lhs % rhs, it must be a different object from quotient.
+     */
+    friend void divmod(const basic_bigint &lhs, const basic_bigint &rhs, basic_bigint &quotient, basic_bigint &remainder)
+    {
+        if (rhs == 0)
+        {
+            throw std::invalid_argument("Cannot divide by zero."); // std::invalid_argument if division by zero
+        }
+        const bool lhs_positive = lhs.is_Positive, rhs_positive = rhs.is_Positive; // The results may overwrite the operands
+        basic_bigint::div_magnitude(lhs, rhs, quotient, remainder);
+        quotient.is_Positive = (lhs_positive == rhs_positive);
+        quotient.trim();
+        remainder.is_Positive = lhs_positive;
+        remainder.trim();
+    }
+
+    /**
+     * @brief Computes the quotient and the remainder of a division at once.
+     *
+     * @param lhs The dividend bigint.
+     * @param rhs The divisor bigint.
+     * @return The pair {lhs / rhs, lhs % rhs}.
+     */
+    friend std::pair<basic_bigint, basic_bigint> divmod(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        std::pair<basic_bigint, basic_bigint> ret(basic_bigint(lhs.get_allocator()), basic_bigint(lhs.get_allocator()));
+        divmod(lhs, rhs, ret.first, ret.second);
+        return ret;
+    }
+
+    /**
+     * @brief Fused multiply-accumulate: acc += a * b and acc -= a * b, the building blocks of dot products and
+     * polynomial evaluation.
+     *
+     * The product is accumulated into the limbs of acc without a temporary bigint: when one factor is shorter than
+     * BIGINT_KARATSUBA_THRESHOLD limbs, one row per limb of it is added to (or subtracted from) acc in a single sweep,
+     * otherwise the product is computed in the scratch space of the thread and added from there.
+     * acc may be one of the factors.
+     *
+     * @param acc The accumulator.
+     * @param a The first factor.
+     * @param b The second factor.
+     */
+    friend void addmul(basic_bigint &acc, const basic_bigint &a, const basic_bigint &b)
+    {
+        acc.add_product(a, b, false);
+    }
+    friend void submul(basic_bigint &acc, const basic_bigint &a, const basic_bigint &b)
+    {
+        acc.add_product(a, b, true);
+    }
+
+    /**
+     * @brief Fused multiply-accumulate with a native integer factor: acc += a * b and acc -= a * b, in one sweep
+     * over the limbs of a.
+     *
+     * @param acc The accumulator.
+     * @param a The bigint factor.
+     * @param b The integer factor.
+     */
+    template <bigint_detail::native_integer T>
+    friend void addmul(basic_bigint &acc, const basic_bigint &a, T b)
+    {
+        acc.add_product_native(a, !bigint_detail::is_negative(b), bigint_detail::magnitude(b), false);
+    }
+    template <bigint_detail::native_integer T>
+    friend void submul(basic_bigint &acc, const basic_bigint &a, T b)
+    {
+        acc.add_product_native(a, !bigint_detail::is_negative(b), bigint_detail::magnitude(b), true);
+    }
+
+    /**
+     * @name Arithmetic operators with native integers
+     * @brief Overloads taking int64_t, uint64_t and the other integer types directly. They run single-limb kernels
+     * instead of converting the integer to a bigint and running the general algorithm.
+     */
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator+(const basic_bigint &lhs, T rhs)
+    {
+        basic_bigint ret(lhs, lhs.get_allocator());
+        ret += rhs;
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator+(T lhs, const basic_bigint &rhs)
+    {
+        basic_bigint ret(rhs, rhs.get_allocator());
+        ret += lhs;
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator-(const basic_bigint &lhs, T rhs)
+    {
+        basic_bigint ret(lhs, lhs.get_allocator());
+        ret -= rhs;
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator+(basic_bigint &&lhs, T rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator+(T lhs, basic_bigint &&rhs)
+    {
+        rhs += lhs;
+        return std::move(rhs);
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator-(basic_bigint &&lhs, T rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator-(T lhs, const basic_bigint &rhs)
+    {
+        basic_bigint ret(-rhs);
+        ret += lhs;
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator*(const basic_bigint &lhs, T rhs)
+    {
+        basic_bigint ret(lhs, lhs.get_allocator());
+        ret *= rhs;
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator*(T lhs, const basic_bigint &rhs)
+    {
+        basic_bigint ret(rhs, rhs.get_allocator());
+        ret *= lhs;
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator*(basic_bigint &&lhs, T rhs)
+    {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator*(T lhs, basic_bigint &&rhs)
+    {
+        rhs *= lhs;
+        return std::move(rhs);
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator/(basic_bigint &&lhs, T rhs)
+    {
+        lhs /= rhs;
+        return std::move(lhs);
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator/(const basic_bigint &lhs, T rhs)
+    {
+        basic_bigint ret(lhs, lhs.get_allocator());
+        ret /= rhs;
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator%(const basic_bigint &lhs, T rhs) // Reads lhs once, without computing the quotient
+    {
+        if (rhs == 0)
+        {
+            throw std::invalid_argument("Cannot divide by zero."); // std::invalid_argument if division by zero
+        }
+        basic_bigint ret(lhs.get_allocator());
+        ret.assign_native(lhs.is_Positive, basic_bigint::mod_limb(lhs.vec, bigint_detail::magnitude(rhs)));
+        return ret;
+    }
+    template <bigint_detail::native_integer T>
+    friend basic_bigint operator%(basic_bigint &&lhs, T rhs)
+    {
+        const basic_bigint &value = lhs; // The remainder fits in one limb, nothing to reuse
+        return value % rhs;
+    }
+
+    /**
+     * @brief Compares a bigint with a native integer. The other comparison operators (in both orders) are
+     * rewritten from these two by the compiler.
+     */
+    template <bigint_detail::native_integer T>
+    friend bool operator==(const basic_bigint &lhs, T rhs)
+    {
+        return lhs.compare_native(!bigint_detail::is_negative(rhs), bigint_detail::magnitude(rhs)) == 0;
+    }
+    template <bigint_detail::native_integer T>
+    friend std::strong_ordering operator<=>(const basic_bigint &lhs, T rhs)
+    {
+        return lhs.compare_native(!bigint_detail::is_negative(rhs), bigint_detail::magnitude(rhs)) <=> 0;
+    }
+
+    /**
+     * @name Comparison operators
+     * @brief Overloaded comparison operators for the bigint class. And return a boolean result.
+     *
+     * The relational operators are all built on operator<=>, which scans the limbs once, from the most significant
+     * one, and stops at the first difference.
+     */
+
+    /**
+     * @brief Compares the absolute values of two bigints without copying them.
+     *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return The order of |lhs| and |rhs|.
+     */
+    friend std::strong_ordering compare_magnitude(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        return basic_bigint::cmp_n(lhs.vec.data(), lhs.vec.size(), rhs.vec.data(), rhs.vec.size()) <=> 0;
+    }
+
+    /**
+     * @brief Three-way comparison of two bigints.
+     *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return The order of lhs and rhs.
+     */
+    friend std::strong_ordering operator<=>(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        if (lhs.is_Positive != rhs.is_Positive)
+        {
+            return lhs.is_Positive ? std::strong_ordering::greater : std::strong_ordering::less; // Zero is positive
+        }
+        const int order = basic_bigint::cmp_n(lhs.vec.data(), lhs.vec.size(), rhs.vec.data(), rhs.vec.size());
+        return (lhs.is_Positive ? order : -order) <=> 0; // For negative numbers, the bigger magnitude is smaller
+    }
+
+    /**
+     * @brief Overloads the > operator for bigint.
+     *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return If lhs is greater than rhs, return true, otherwise false.
+     */
+    friend bool operator>(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        return (lhs <=> rhs) > 0;
+    }
+
+    /**
+     * @brief Overloads the == operator for bigint.
+     *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return If lhs is equal to rhs, return true, otherwise false.
+     */
+    friend bool operator==(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        // Different sign or size means they are not equal, which is checked before reading any limb
+        return lhs.is_Positive == rhs.is_Positive && lhs.vec.size() == rhs.vec.size() &&
+               std::equal(lhs.vec.begin(), lhs.vec.end(), rhs.vec.begin());
+    }
+
+    /**
+     * @brief Overloads the >= operator for bigint.
+     *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return If lhs is greater than or equal to rhs, return true, otherwise false.
+     */
+    friend bool operator>=(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        return (lhs <=> rhs) >= 0;
+    }
+
+    /**
+     * @brief Overloads the < operator for bigint.
+     *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return If lhs is less than rhs, return true, otherwise false.
+     */
+    friend bool operator<(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        return (lhs <=> rhs) < 0;
+    }
+
+    /**
+     * @brief Overloads the <= operator for bigint.
+     *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return If lhs is less than or equal to rhs, return true, otherwise false.
+     */
+    friend bool operator<=(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        return (lhs <=> rhs) <= 0;
+    }
+
+    /**
+     * @brief Overloads the != operator for bigint.
+     * *
+     * @param lhs The first bigint object.
+     * @param rhs The second bigint object.
+     * @return If lhs is not equal to rhs, return true, otherwise false.
+     */
+    friend bool operator!=(const basic_bigint &lhs, const basic_bigint &rhs)
+    {
+        return !(lhs == rhs); // convert to the !== case.
+    }
+
+    /**
+     * @name Stream operators
+     * @brief Overloaded output stream for the bigint class.
+     *
+     */
+
+    /**
+     * @brief Overloads the << operator for bigint output.
+     *
+     * @param out The output stream.
+     * @param rhs A constant reference to the bigint object to be output.
+     * @return A reference to the output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &out, const basic_bigint &rhs)
+    {
+        // The digits are written in the scratch space of the thread, not in a temporary string
+        bigint_detail::scratch_frame frame;
+        char *digits = reinterpret_cast<char *>(frame.take(rhs.digits10_upper_bound() / sizeof(limb_type) + 1));
+        const std::string_view text(digits, rhs.write_decimal(digits));
+        if (out.width() > 0)
+        {
+            out << text; // Padded to the field width
+        }
+        else
+        {
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+        return out;
+    }
+
+    /**
+     * @name Character conversions
+     * @brief Conversions from and to caller-provided character ranges, in the manner of std::to_chars and
+     * std::from_chars. They do not allocate, apart from the limbs of the parsed bigint.
+     */
+
+    /**
+     * @brief Writes the decimal representation of x into [first, last), with a '-' if x is negative.
+     *
+     * A buffer of x.digits10_upper_bound() characters is always enough. A smaller buffer that still holds the
+     * digits works too: they are then converted in the scratch space of the thread first.
+     *
+     * @param first The beginning of the buffer.
+     * @param last The end of the buffer.
+     * @param x The bigint to write.
+     * @return {end of the written characters, std::errc()} on success, or {last, std::errc::value_too_large}
+     * when the buffer is too small, in which case its contents are unspecified.
+     */
+    friend std::to_chars_result to_chars(char *first, char *last, const basic_bigint &x)
+    {
+        const size_t room = static_cast<size_t>(last - first), bound = x.digits10_upper_bound();
+        if (room >= bound)
+        {
+            return {first + x.write_decimal(first), std::errc()};
+        }
+        bigint_detail::scratch_frame frame;
+        char *digits = reinterpret_cast<char *>(frame.take(bound / sizeof(limb_type) + 1));
+        const size_t n = x.write_decimal(digits);
+        if (n > room)
+        {
+            return {last, std::errc::value_too_large};
+        }
+        std::copy(digits, digits + n, first);
+        return {first + n, std::errc()};
+    }
+
+    /**
+     * @brief Parses a decimal integer at the beginning of [first, last) into x: an optional '-', then digits.
+     *
+     * As std::from_chars, there is no '+' nor whitespace, and the parsing stops at the first character that is not
+     * a digit. Long numbers are converted by divide and conquer, as for the string constructor.
+     *
+     * @param first The beginning of the characters.
+     * @param last The end of the characters.
+     * @param x Receives the value. It is left unchanged when there is no digit.
+     * @return {one past the last digit, std::errc()} on success, or {first, std::errc::invalid_argument} when
+     * there is no digit.
+     */
+    friend std::from_chars_result from_chars(const char *first, const char *last, basic_bigint &x)
+    {
+        return from_chars(first, last, x, 10);
+    }
+
+    /**
+     * @brief Writes x in the given base into [first, last), like to_chars above, with lowercase letters for the
+     * digits from 10 to 35 and no prefix. A buffer of x.digits_upper_bound(base) characters is always enough.
+     *
+     * @param first The beginning of the buffer.
+     * @param last The end of the buffer.
+     * @param x The bigint to write.
+     * @param base The base, from 2 to 36.
+     * @return {end of the written characters, std::errc()}, or {last, std::errc::value_too_large}.
+     * @throws std::invalid_argument If the base is not between 2 and 36.
+     */
+    friend std::to_chars_result to_chars(char *first, char *last, const basic_bigint &x, int base)
+    {
+        const size_t room = static_cast<size_t>(last - first), bound = x.digits_upper_bound(base);
+        if (room >= bound)
+        {
+            return {first + x.write_radix(first, static_cast<unsigned>(base)), std::errc()};
+        }
+        bigint_detail::scratch_frame frame;
+        char *digits = reinterpret_cast<char *>(frame.take(bound / sizeof(limb_type) + 1));
+        const size_t n = x.write_radix(digits, static_cast<unsigned>(base));
+        if (n > room)
+        {
+            return {last, std::errc::value_too_large};
+        }
+        std::copy(digits, digits + n, first);
+        return {first + n, std::errc()};
+    }
+
+    /**
+     * @brief Parses an integer in the given base at the beginning of [first, last) into x, like from_chars above.
+     * Letters of either case are digits from 10 to 35, and there is no prefix such as "0x".
+     *
+     * @param first The beginning of the characters.
+     * @param last The end of the characters.
+     * @param x Receives the value. It is left unchanged when there is no digit.
+     * @param base The base, from 2 to 36.
+     * @return {one past the last digit, std::errc()}, or {first, std::errc::invalid_argument} when there is no digit.
+     * @throws std::invalid_argument If the base is not between 2 and 36.
+     */
+    friend std::from_chars_result from_chars(const char *first, const char *last, basic_bigint &x, int base)
+    {
+        bigint_detail::check_base(base);
+        const char *p = first;
+        const bool positive = !(p != last && *p == '-');
+        if (!positive)
+        {
+            ++p;
+        }
+        const char *digits = p;
+        while (p != last && bigint_detail::digit_value(*p) < static_cast<unsigned>(base))
+        {
+            ++p;
+        }
+        if (p == digits)
+        {
+            return {first, std::errc::invalid_argument};
+        }
+        x.assign_radix(digits, static_cast<size_t>(p - digits), static_cast<unsigned>(base));
+        x.is_Positive = positive;
+        x.trim();
+        return {p, std::errc()};
+    }
+
+    /**
+     * @brief Calculate the square of a bigint, with the squaring kernels (each cross product is computed once).
+     *
+     * @param x The bigint to square.
+     * @return The result of x * x.
+     */
+    friend basic_bigint sqr(const basic_bigint &x)
+    {
+        return basic_bigint::mul_signed(x, x);
+    }
+
+    /**
+     * @brief Calculate the power of a bigint raised to a bigint exponent.
+     *
+     * @param base The base bigint.
+     * @param exponent The exponent bigint.
+     * @return The result of base raised to the power of exponent.
+     */
+    friend basic_bigint pow(const basic_bigint &base, const basic_bigint &exponent)
+    {
+        if (!exponent.is_Positive) // Exponent must be non negative
+        {
+            throw std::invalid_argument("Negative exponent is not supported for bigint."); // std::invalid_argument If the exponent is negative.
+        }
+
+        if (exponent == basic_bigint::s_zero) // Any number raised to the power of 0 is 1.
+        {
+            return basic_bigint(basic_bigint::s_one, base.get_allocator());
+        }
+
+        if (base == basic_bigint::s_zero) // 0 raised to any power is 0
+        {
+            return basic_bigint(basic_bigint::s_zero, base.get_allocator());
+        }
+
+        basic_bigint ret(basic_bigint::s_one, base.get_allocator()); // Result starts at 1
+        basic_bigint base2(base, base.get_allocator());             // Copy of the base
+        basic_bigint exp(exponent, base.get_allocator());           // Copy of the exponent
+
+        while (exp > 0)
+        {
+            if (exp % 2 == 1) // If the current exponent is odd
+            {
+                ret *= base2;
+            }
+            exp /= 2; // Divide the exponent by 2
+            if (exp > 0)
+            {
+                base2 = sqr(base2); // Square the base, except after the last bit where it would be unused
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Returns the bigint value as a string.
+     *
+     * @return Get the string representation of the bigint.
+     */
+    std::string get_value() const;
+
+    /**
+     * @brief Returns the number of characters that is enough for the decimal representation of the bigint,
+     * its sign included: the size of a buffer for to_chars. It is exact for decimal limbs, and at most one more
+     * than needed for binary limbs.
+     *
+     * @return The upper bound, computed from the number of limbs and the top limb only.
+     */
+    size_t digits10_upper_bound() const;
+
+    /**
+     * @brief Returns the bigint value as a string of digits in the given base, with lowercase letters above 9 and
+     * without prefix. Power-of-two bases take linear time with binary limbs.
+     *
+     * @param base The base, from 2 to 36.
+     * @return The string representation in this base.
+     * @throws std::invalid_argument If the base is not between 2 and 36.
+     */
+    std::string get_value(int base) const;
+
+    /**
+     * @brief Returns the number of characters that is enough for the representation in the given base, its sign
+     * included: the size of a buffer for to_chars with this base. It is exact for power-of-two bases with binary
+     * limbs.
+     *
+     * @param base The base, from 2 to 36.
+     * @return The upper bound, computed from the number of limbs and the top limb only.
+     * @throws std::invalid_argument If the base is not between 2 and 36.
+     */
+    size_t digits_upper_bound(int base) const;
+
+    /**
+     * @brief Checks if the bigint is positive.
+     *
+     * @return if the bigint is positive return true, otherwise return false.
+     */
+    bool get_positive();
+
+    /**
+     * @brief Returns the size of the vec, i.e. the number of limbs.
+     *
+     * @return The size of the vec.
+     */
+    size_t get_vec_size() const
+    {
+        return vec.size();
+    }
+
+    /**
+     * @brief Remove any leading zeros from the stored digits
+     *
+     */
+    void trim();
+
+private:
+    /**
+     * @name Private members
+     * @brief These are private member variables and functions for internal use.
+     */
+
+    /**
+     * @brief Types of a single limb and of the double-width intermediate used by the limb kernels.
+     */
+    using limb_type = uint64_t;
+    __extension__ typedef unsigned __int128 double_limb_type;
+
+    /**
+     * @brief Storage of the limbs: the first BIGINT_INLINE_LIMBS limbs live inside the object, so small values never allocate.
+     */
+    using limb_vector = bigint_detail::small_vector<limb_type, BIGINT_INLINE_LIMBS, Alloc>;
+
+    /**
+     * @brief Number of bits in a limb.
+     */
+    static constexpr unsigned limb_bits = 64;
+
+    /**
+     * @brief Returns the number of decimal digits in a limb when the radix is a power of ten, otherwise 0.
+     */
+    static constexpr size_t decimal_digits_of(limb_type radix)
+    {
+        size_t digits = 0;
+        while (radix > 1 && radix % 10 == 0)
+        {
+            radix /= 10;
+            ++digits;
+        }
+        return radix == 1 ? digits : 0;
+    }
+
+    /**
+     * @brief True if the limbs are binary (base 2^64), false if they are decimal (base Radix).
+     */
+    static constexpr bool is_binary = (Radix == 0);
+    static_assert(is_binary || (decimal_digits_of(Radix) > 0 && decimal_digits_of(Radix) <= 18), "Radix must be 0 (2^64) or a power of ten between 10 and 10^18");
+
+    /**
+     * @brief The power of ten used to convert decimal strings and its number of decimal digits.
+     * Binary limbs use the biggest power of ten that fits in a limb (10^19), decimal limbs use the radix itself.
+     */
+    static constexpr limb_type s_decimal_chunk = is_binary ? 10000000000000000000ULL : Radix;
+    static constexpr size_t s_decimal_chunk_digits = is_binary ? 19 : decimal_digits_of(Radix);
+
+    /**
+     * @brief Number of pieces a limb is cut into for the number-theoretic transform, and the base of one piece.
+     * Binary limbs use two 32-bit pieces, decimal limbs use pieces of at most 9 decimal digits.
+     */
+    static constexpr size_t pieces_per_limb_of(size_t digits)
+    {
+        size_t k = 1;
+        while (digits % k != 0 || digits / k > 9)
+        {
+            ++k;
+        }
+        return k;
+    }
+    static constexpr size_t s_fft_pieces = is_binary ? 2 : pieces_per_limb_of(decimal_digits_of(Radix));
+    static constexpr uint64_t s_fft_piece_base = []
+    {
+        if (is_binary)
+        {
+            return uint64_t(1) << 32;
+        }
+        uint64_t base = 1;
+        for (size_t i = 0; i < decimal_digits_of(Radix) / s_fft_pieces; ++i)
+        {
+            base *= 10;
+        }
+        return base;
+    }();
+
+    /**
+     * @brief A vector to store the magnitude of the bigint. Each element of the vector is a limb in base 2^64
+     * (or base Radix for decimal limbs), so the value is sum(vec[i] * base^i). In reverse order (least significant limb first).
+     */
+    limb_vector vec;
+
+    /**
+     * @brief Limb kernels shared by the arithmetic operators. They hide the difference between binary and decimal limbs.
+     */
+    static limb_type add_limbs(limb_type a, limb_type b, limb_type &carry);                    // a + b + carry, carry out
+    static limb_type sub_limbs(limb_type a, limb_type b, limb_type &borrow);                   // a - b - borrow, borrow out
+    static limb_type mul_add_limbs(limb_type a, limb_type b, limb_type add, limb_type &carry); // a * b + add + carry, carry out
+
+    /**
+     * @brief Kernels on raw limb arrays (least significant limb first), used by the multiplication algorithms.
+     */
+    static limb_type add_n(limb_type *r, const limb_type *a, size_t an, const limb_type *b, size_t bn);         // r = a + b (an >= bn), returns the carry
+    static limb_type sub_n(limb_type *r, const limb_type *a, size_t an, const limb_type *b, size_t bn);         // r = a - b (an >= bn), returns the borrow
+    static int cmp_n(const limb_type *a, size_t an, const limb_type *b, size_t bn);                             // Sign of a - b, both trimmed
+    static limb_type addmul_1(limb_type *r, const limb_type *a, size_t n, limb_type q);                         // r += a * q (n limbs), returns the carry limb
+    static void mul_basecase(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res);      // Schoolbook multiplication
+    static void sqr_basecase(const limb_type *a, size_t n, limb_type *res);                                      // Schoolbook squaring
+    static void mul_karatsuba(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res);     // Karatsuba multiplication
+    static constexpr size_t karatsuba_scratch(size_t n);                                                         // Scratch words used by mul_karatsuba and its recursion
+    static void mul_toom3(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res);         // Toom-Cook 3-way multiplication
+    static void mul_toom4(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res);         // Toom-Cook 4-way multiplication
+    static bool fft_fits(size_t an, size_t bn);                                                                  // Whether mul_fft is exact for these sizes
+    static void mul_fft(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res);           // Three-prime NTT multiplication
+    static void mul_limbs(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res);         // Chooses the algorithm, squares when a == b
+
+    /**
+     * @brief Helpers for the Toom-Cook evaluation and interpolation, where intermediate values can be negative.
+     */
+    static basic_bigint from_limbs(const limb_type *p, size_t n);                 // The positive bigint held by n limbs (n may be 0)
+    static basic_bigint mul_signed(const basic_bigint &x, const basic_bigint &y); // x * y through mul_limbs, a square when &x == &y
+    static void div_exact(basic_bigint &x, limb_type d);                          // x /= d, the division must be exact
+    static void add_shifted(limb_type *res, size_t rn, const basic_bigint &c, size_t shift); // res += c * base^shift
+
+    /**
+     * @brief Kernels of the long division.
+     */
+    static limb_type submul_1(limb_type *r, const limb_type *a, size_t n, limb_type q);            // r -= a * q, returns the limb to subtract from r[n]
+    static void div_basecase(limb_type *q, limb_type *u, size_t un, const limb_type *v, size_t vn); // Knuth's Algorithm D on normalized operands
+    static limb_type div_recursive(limb_type *q, limb_type *u, size_t m, const limb_type *v, size_t n); // Divide-and-conquer division, in place
+    static void div_normalized(limb_type *q, limb_type *u, size_t un, const limb_type *v, size_t vn); // q = u / v, remainder in u
+    static void div_magnitude(const basic_bigint &a, const basic_bigint &b, basic_bigint &q, basic_bigint &r); // |a| = q * |b| + r
+
+    /**
+     * @brief Multiplies the magnitude by a single limb and adds another limb: vec = vec * mul + add.
+     */
+    void mul_add_limb(limb_type mul, limb_type add);
+
+    /**
+     * @brief Kernels of the operators taking native integers. The integer is given as a sign and a magnitude.
+     */
+    void assign_native(bool positive, uint64_t m);         // *this = +-m, reusing the limb buffer
+    void add_native(bool positive, uint64_t m);            // *this += +-m
+    int compare_native(bool positive, uint64_t m) const;   // Sign of *this - (+-m)
+    static uint64_t mod_limb(const limb_vector &v, uint64_t div); // The magnitude in v modulo div
+
+    /**
+     * @brief In-place kernels of += and -=, addmul, submul and of the lazy expressions of bigint_expr.
+     */
+    friend struct bigint_expr::access;
+    void add_signed(const limb_type *p, size_t n, bool positive);                  // *this += +-p, p not in vec
+    void add_value(const basic_bigint &x, bool negate);                            // *this += x, or -= x
+    void add_product(const basic_bigint &x, const basic_bigint &y, bool negate);   // *this += x * y, or -= x * y
+    void add_product_native(const basic_bigint &x, bool positive, uint64_t m, bool negate); // *this += x * (+-m), or -=
+    void add_rows(const limb_type *a, size_t an, const limb_type *b, size_t bn, bool positive); // *this += +-a * b, row by row
+    void assign_product(const basic_bigint &x, const basic_bigint &y);             // *this = x * y, reusing the limb buffer
+
+    void reset_moved_from() noexcept; // Leaves this bigint equal to zero after its limbs were moved out
+
+    /**
+     * @brief Divides the magnitude stored in v by a single limb in place and returns the remainder.
+     */
+    static limb_type div_limb(limb_vector &v, limb_type div);
+
+    /**
+     * @brief Parses len decimal digits into the magnitude. The digits must be already validated.
+     */
+    void assign_decimal(const char *digits, size_t len);
+
+    /**
+     * @brief Writes the sign and the digits into out, which must hold digits10_upper_bound() characters.
+     * Returns the number of characters written.
+     */
+    size_t write_decimal(char *out) const;
+#if defined(__cpp_lib_format)
+    friend struct std::formatter<basic_bigint, char>; // Writes the digits with write_decimal
+#endif
+
+    /**
+     * @brief Conversions in any base from 2 to 36. Base 10 uses the decimal conversions, power-of-two bases slice the
+     * bits of binary limbs, and other bases go through chunks of digits that fit in a limb.
+     */
+    void assign_radix(const char *digits, size_t len, unsigned base); // Like assign_decimal, the digits are validated
+    void assign_string(const std::string &str, int base);             // Validates str and base, then assigns the value
+    size_t write_radix(char *out, unsigned base) const;              // Like write_decimal, out holds digits_upper_bound(base) characters
+    static unsigned chunk_digits(unsigned base, limb_type &chunk);    // Digits per chunk, chunk = base^digits
+
+    /**
+     * @brief Conversion between decimal digits and binary limbs. A piece of 19 * 2^i digits fits in 2^i limbs, so the
+     * digits are split into such pieces, which are combined with (or divided by) the powers (10^19)^(2^i).
+     */
+    struct power_of_ten
+    {
+        std::vector<limb_type> limbs;   // p, the power is p * base^zeros
+        size_t zeros;                   // Number of zero limbs below p
+        std::vector<limb_type> inverse; // floor(base^(2n) / p) with n the limbs of p, empty until needed
+    };
+    static std::deque<power_of_ten> &decimal_power_table();                          // The powers cached by the thread
+    static const power_of_ten &decimal_power(size_t i, bool inverse);                 // (10^19)^(2^i), with its inverse if asked
+    static void trim_decimal_powers();                                                // Keeps at most BIGINT_SCRATCH_KEEP words of powers
+    static void div_barrett(limb_type *q, limb_type *u, size_t un, const limb_type *p, size_t pn, const limb_type *m, size_t mn); // q = u / p
+    static void parse_decimal(const char *digits, size_t len, limb_type *res);        // res = the len digits, in ceil(len / 19) limbs
+    static void print_decimal(const limb_type *a, size_t n, char *digits, size_t len); // The len digits of a < 10^len, with leading zeros
+    static void write_chunk(char *end, limb_type chunk, size_t count, unsigned base = 10); // The count low digits of chunk, ending before end
+
+    /**
+     * @brief Initializes constexpr static member variables. These members representing zero, one, two, and ten respectively
+     */
+    static const basic_bigint s_zero;
+    static const basic_bigint s_one;
+    static const basic_bigint s_two;
+    static const basic_bigint s_ten;
+
+    /**
+     * @brief Represent the bigint wether is positive.
+     */
+    bool is_Positive;
+};
+
+/**
+ * @brief The default big integer: binary 64-bit limbs.
+ */
+using bigint = basic_bigint<>;
+
+/**
+ * @brief Big integer with 18 decimal digits per limb, for parse-compute-print workloads.
+ */
+using decimal_bigint = basic_bigint<1000000000000000000ULL>;
+
+/**
+ * @brief Big integers whose limbs come from a std::pmr::memory_resource, such as a std::pmr::monotonic_buffer_resource
+ * that releases all of them at once.
+ */
+using pmr_bigint = basic_bigint<0, std::pmr::polymorphic_allocator<uint64_t>>;
+using pmr_decimal_bigint = basic_bigint<1000000000000000000ULL, std::pmr::polymorphic_allocator<uint64_t>>;
+
+/**
+ * @brief Initializes static member variables.
+ */
+
+template <uint64_t Radix, typename Alloc>
+const basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::s_zero = basic_bigint<Radix, Alloc>(0);
+template <uint64_t Radix, typename Alloc>
+const basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::s_one = basic_bigint<Radix, Alloc>(1);
+template <uint64_t Radix, typename Alloc>
+const basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::s_two = basic_bigint<Radix, Alloc>(2);
+template <uint64_t Radix, typename Alloc>
+const basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::s_ten = basic_bigint<Radix, Alloc>(10);
+
+/**
+ * @brief Default constructor for bigint. Initializes the bigint to zero with a positive sign.
+ *
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint()
+{
+    // vec.clear();
+    vec.push_back(0);
+    is_Positive = true;
+}
+
+/**
+ * @brief Constructs a bigint from a 64-bit integer.
+ *
+ * @param a The 64-bit integer, initializing the bigint.
+ */
+
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const int64_t &a)
+{
+    vec.clear();
+
+    if (a >= 0)
+    {
+        is_Positive = true;
+    }
+    else
+    {
+        is_Positive = false;
+    }
+    // If the value is zero, store it and exit
+    if (a == 0)
+    {
+        vec.push_back(0);
+        return;
+    }
+
+    // use uint64_t to handle the negative number to avoid overflow of int64_t
+    uint64_t temp_val;
+    if (a == INT64_MIN)
+    {
+        temp_val = static_cast<uint64_t>(INT64_MAX) + 1;
+    }
+    else
+    {
+        if (a >= 0)
+        {
+            temp_val = static_cast<uint64_t>(a);
+        }
+        else
+        {
+            temp_val = static_cast<uint64_t>(-a);
+        }
+    }
+
+    if constexpr (is_binary)
+    {
+        vec.push_back(temp_val); // A 64-bit magnitude always fits in a single binary limb
+    }
+    else
+    {
+        // Split the magnitude into decimal limbs
+        while (temp_val > 0)
+        {
+            vec.push_back(temp_val % Radix);
+            temp_val /= Radix;
+        }
+    }
+}
+
+/**
+ * @brief Constructs a bigint from a string.
+ *
+ * @param str The string used to initialize the bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const std::string &str)
+{
+    // check wether the str is empty.
+    if (str.empty())
+    {
+        throw std::invalid_argument("Input string is empty"); // std::invalid_argument: If the string is empty.
+    }
+    vec.clear();
+    is_Positive = true;
+    size_t temp = 0;
+    if (str[0] == '-')
+    {
+        is_Positive = false;
+        temp = 1; // The indicator for skipping the '-'.
+    }
+    if (str.length() == temp)
+    {
+        throw std::invalid_argument("Input string is only '-' or empty"); // std::invalid_argument: If the string is '-'.
+    }
+
+    for (size_t i = str.length(); i-- > temp;)
+    {
+        if (!std::isdigit(str[i]))
+        {
+            throw std::invalid_argument("Input string contains non-digit character"); // std::invalid_argument: If the string contains non-digit character.
+        }
+    }
+    assign_decimal(str.data() + temp, str.length() - temp);
+    trim();
+}
+
+/**
+ * @brief Constructs a bigint from a string of digits in the given base: an optional '-', then digits, with letters
+ * in either case for the digits from 10 to 35, and no prefix such as "0x".
+ *
+ * @param str The string used to initialize the bigint.
+ * @param base The base, from 2 to 36.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const std::string &str, int base) : basic_bigint()
+{
+    assign_string(str, base);
+}
+
+/**
+ * @brief Copy constructor for bigint. Like the standard containers, the copy takes the allocator given by
+ * select_on_container_copy_construction: the default memory resource for pmr_bigint, not the one of a.
+ *
+ * @param a This is bigint object which be copied.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const basic_bigint &a) : vec(a.vec), is_Positive(a.is_Positive)
+{
+}
+
+/**
+ * @brief Leaves a moved-from bigint equal to zero. Its limb vector has at least its inline capacity, so the single
+ * limb never allocates.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::reset_moved_from() noexcept
+{
+    vec.assign(1, limb_type(0));
+    is_Positive = true;
+}
+
+/**
+ * @brief Move constructor for bigint. Takes over the limb buffer of a, without allocating or copying.
+ *
+ * @param a The bigint to move from. It is left equal to zero, in its inline limb.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(basic_bigint &&a) noexcept : vec(std::move(a.vec)), is_Positive(a.is_Positive)
+{
+    a.reset_moved_from();
+}
+
+/**
+ * @brief Constructs a bigint equal to zero whose limbs are allocated by alloc.
+ *
+ * @param alloc The allocator of the limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const Alloc &alloc) : vec(1, 0, alloc), is_Positive(true)
+{
+}
+
+/**
+ * @brief Constructs a bigint from a 64-bit integer, with its limbs allocated by alloc.
+ *
+ * @param a The 64-bit integer, initializing the bigint.
+ * @param alloc The allocator of the limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const int64_t &a, const Alloc &alloc) : basic_bigint(alloc)
+{
+    *this = a;
+}
+
+/**
+ * @brief Constructs a bigint from a string, with its limbs allocated by alloc.
+ *
+ * @param s The string, in the same format as for the constructor without allocator.
+ * @param alloc The allocator of the limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const std::string &s, const Alloc &alloc) : basic_bigint(alloc)
+{
+    *this = s;
+}
+
+/**
+ * @brief Constructs a bigint from a string of digits in the given base, with its limbs allocated by alloc.
+ *
+ * @param s The string, in the same format as for the constructor without allocator.
+ * @param base The base, from 2 to 36.
+ * @param alloc The allocator of the limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const std::string &s, int base, const Alloc &alloc) : basic_bigint(alloc)
+{
+    assign_string(s, base);
+}
+
+/**
+ * @brief Copies a bigint into limbs allocated by alloc.
+ *
+ * @param a The bigint to copy.
+ * @param alloc The allocator of the limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(const basic_bigint &a, const Alloc &alloc) : vec(a.vec, alloc), is_Positive(a.is_Positive)
+{
+}
+
+/**
+ * @brief Moves a bigint into limbs allocated by alloc. The limb buffer of a is taken over when its allocator is
+ * equal to alloc, otherwise the limbs are copied.
+ *
+ * @param a The bigint to move from.
+ * @param alloc The allocator of the limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc>::basic_bigint(basic_bigint &&a, const Alloc &alloc) : vec(std::move(a.vec), alloc), is_Positive(a.is_Positive)
+{
+    a.reset_moved_from();
+}
+
+/**
+ * @brief Constructs a bigint holding the value of a lazy expression.
+ *
+ * @param expr The expression, built by the operators of bigint_expr.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_expr::expression_of<basic_bigint<Radix, Alloc>> E>
+basic_bigint<Radix, Alloc>::basic_bigint(const E &expr) : basic_bigint()
+{
+    expr.evaluate_into(*this);
+}
+
+/**
+ * @brief Constructs a bigint holding the value of a lazy expression, with its limbs (and the temporaries of the
+ * evaluation) allocated by alloc.
+ *
+ * @param expr The expression, built by the operators of bigint_expr.
+ * @param alloc The allocator of the limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_expr::expression_of<basic_bigint<Radix, Alloc>> E>
+basic_bigint<Radix, Alloc>::basic_bigint(const E &expr, const Alloc &alloc) : basic_bigint(alloc)
+{
+    expr.evaluate_into(*this);
+}
+
+/**
+ * @brief Overloaded assignment operator for bigint. The limbs are copied into the existing buffer, which is only
+ * reallocated when it is too small.
+ *
+ * @param a The bigint to be assigned.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator=(const basic_bigint &a)
+{
+    if (this != &a)
+    {
+        vec.assign(a.vec.begin(), a.vec.end());
+        is_Positive = a.is_Positive; // Align the sign.
+    }
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator for bigint. Swaps the limb buffers, so a keeps the old buffer of this bigint and
+ * releases it when it is destroyed; a itself is left equal to zero.
+ *
+ * @param a The bigint to move from.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator=(basic_bigint &&a) noexcept(nothrow_swap)
+{
+    if (this != &a)
+    {
+        swap(a);
+        a.reset_moved_from();
+    }
+    return *this;
+}
+
+/**
+ * @brief Exchanges the values of two bigints.
+ *
+ * @param other The other bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::swap(basic_bigint &other) noexcept(nothrow_swap)
+{
+    vec.swap(other.vec);
+    std::swap(is_Positive, other.is_Positive);
+}
+
+/**
+ * @brief Assigns an int64_t value to the bigint.
+ *
+ * @param a The 64-bit integer to be assigned.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator=(const int64_t &a)
+{
+    assign_native(!bigint_detail::is_negative(a), bigint_detail::magnitude(a)); // Reuses the limb buffer
+    return *this;
+}
+
+/**
+ * @brief Assigns a string value to this bigint.
+ *
+ * @param str The string which will be assigned to the bigint.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator=(const std::string &str)
+{
+    if (str.empty())
+    {
+        throw std::invalid_argument("Input string is empty"); // std::invalid_argument If the string is empty
+    }
+    size_t temp = 0;
+    bool sign = true;
+    if (str[0] == '-')
+    {
+        sign = false;
+        temp = 1;
+    }
+
+    if (str.length() == temp)
+    {
+        throw std::invalid_argument("Input string is only '-' or empty"); // std::invalid_argument If the string is only '-'.
+    }
+
+    // Validate every character before touching the current value
+    for (size_t i = temp; i < str.length(); ++i)
+    {
+        if (!std::isdigit(str[i]))
+        {
+            throw std::invalid_argument("Input string contains non-digit character"); // std::invalid_argument If the string contains any non-digit characters.
+        }
+    }
+
+    vec.clear();
+    is_Positive = sign;
+    assign_decimal(str.data() + temp, str.length() - temp);
+    trim();
+    return *this;
+}
+
+/**
+ * @brief Returns the representation of the string of the bigint.
+ *
+ * The string is sized once with digits10_upper_bound(), then the digits are written into it.
+ *
+ * @return A string representing the bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+std::string basic_bigint<Radix, Alloc>::get_value() const
+{
+    if (vec.empty())
+    {
+        throw std::invalid_argument("vec is empty, invalid for bigint."); // std::invalid_argument If the internal vector `vec` is empty.
+    }
+    std::string a(digits10_upper_bound(), '0');
+    a.resize(write_decimal(a.data()));
+    return a;
+}
+
+/**
+ * @brief Returns the number of characters that is enough for the decimal representation of the bigint.
+ *
+ * Binary limbs: x < 2^bits has at most floor(bits * log10(2)) + 1 digits, and 30103 / 100000 is just above
+ * log10(2). Decimal limbs: every limb below the top one has exactly s_decimal_chunk_digits digits.
+ *
+ * @return The number of digits, plus one for the sign of a negative bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+size_t basic_bigint<Radix, Alloc>::digits10_upper_bound() const
+{
+    const size_t sign = is_Positive ? 0 : 1;
+    if constexpr (is_binary)
+    {
+        const size_t bits = vec.size() * limb_bits - std::countl_zero(vec.back());
+        return sign + bits * 30103 / 100000 + 1;
+    }
+    else
+    {
+        size_t top_digits = 1;
+        for (limb_type top = vec.back(); top >= 10; top /= 10)
+        {
+            ++top_digits;
+        }
+        return sign + (vec.size() - 1) * s_decimal_chunk_digits + top_digits;
+    }
+}
+
+/**
+ * @brief Returns the representation of the bigint in the given base.
+ *
+ * @param base The base, from 2 to 36.
+ * @return A string of digits in this base, with a '-' for a negative bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+std::string basic_bigint<Radix, Alloc>::get_value(int base) const
+{
+    bigint_detail::check_base(base);
+    if (vec.empty())
+    {
+        throw std::invalid_argument("vec is empty, invalid for bigint."); // std::invalid_argument If the internal vector `vec` is empty.
+    }
+    std::string a(digits_upper_bound(base), '0');
+    a.resize(write_radix(a.data(), static_cast<unsigned>(base)));
+    return a;
+}
+
+/**
+ * @brief Returns the number of characters that is enough for the representation in the given base.
+ *
+ * Binary limbs and a power-of-two base: exactly ceil(bits / log2(base)) digits. Otherwise x < 2^L, with L from the
+ * limbs, has at most floor(L / log2(base)) + 1 digits; the division is rounded up a little, so that the rounding of
+ * the floating point numbers can only make the bound one bigger.
+ *
+ * @param base The base, from 2 to 36.
+ * @return The number of digits, plus one for the sign of a negative bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+size_t basic_bigint<Radix, Alloc>::digits_upper_bound(int base) const
+{
+    bigint_detail::check_base(base);
+    if (base == 10)
+    {
+        return digits10_upper_bound();
+    }
+    const size_t sign = is_Positive ? 0 : 1;
+    double log2_value;
+    if constexpr (is_binary)
+    {
+        const size_t bits = vec.size() * limb_bits - std::countl_zero(vec.back());
+        if (std::has_single_bit(static_cast<unsigned>(base)))
+        {
+            const size_t digit_bits = static_cast<size_t>(std::countr_zero(static_cast<unsigned>(base)));
+            return sign + std::max<size_t>(1, (bits + digit_bits - 1) / digit_bits);
+        }
+        log2_value = static_cast<double>(bits);
+    }
+    else
+    {
+        log2_value = std::log2(static_cast<double>(vec.back()) + 1) + static_cast<double>(vec.size() - 1) * std::log2(static_cast<double>(Radix));
+    }
+    return sign + static_cast<size_t>(log2_value / std::log2(static_cast<double>(base)) * (1 + 1e-12)) + 1;
+}
+
+/**
+ * @brief Writes the sign and the decimal digits of the bigint, without leading zeros.
+ *
+ * Binary limbs are converted by print_decimal into the digits10_upper_bound() characters, and the leading zero
+ * that the bound may leave is removed. Decimal limbs give their digits directly.
+ *
+ * @param out The buffer, of at least digits10_upper_bound() characters.
+ * @return The number of characters written.
+ */
+template <uint64_t Radix, typename Alloc>
+size_t basic_bigint<Radix, Alloc>::write_decimal(char *out) const
+{
+    const size_t size = digits10_upper_bound();
+    size_t sign = 0;
+    if (!is_Positive)
+    {
+        out[0] = '-';
+        sign = 1;
+    }
+    char *digits = out + sign;
+    const size_t len = size - sign;
+    if constexpr (is_binary)
+    {
+        print_decimal(vec.data(), vec.size(), digits, len);
+        if (vec.size() > BIGINT_PRINT_DC_THRESHOLD)
+        {
+            trim_decimal_powers();
+        }
+        size_t zeros = 0;
+        while (zeros + 1 < len && digits[zeros] == '0')
+        {
+            ++zeros;
+        }
+        if (zeros > 0)
+        {
+            std::copy(digits + zeros, digits + len, digits);
+        }
+        return size - zeros;
+    }
+    else
+    {
+        char *end = digits + len;
+        for (size_t i = 0; i + 1 < vec.size(); ++i, end -= s_decimal_chunk_digits)
+        {
+            write_chunk(end, vec[i], s_decimal_chunk_digits);
+        }
+        write_chunk(end, vec.back(), static_cast<size_t>(end - digits));
+        return size;
+    }
+}
+
+/**
+ * @brief Checks if the bigint is positive.
+ *
+ * @return If the bigint is positive, then return true, otherwise return false.
+ */
+template <uint64_t Radix, typename Alloc>
+bool basic_bigint<Radix, Alloc>::get_positive()
+{
+    return is_Positive;
+}
+
+/**
+ * @brief Overloads the += operator for bigint addition. The limbs of rhs are read in place: with the same sign the
+ * magnitudes are added, otherwise the smaller magnitude is subtracted from the bigger one, in one pass and without
+ * copying either operand.
+ *
+ * @param rhs is the bigint value to be added. It may be this bigint.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator+=(const basic_bigint &rhs)
+{
+    add_value(rhs, false);
+    return *this;
+}
+
+/**
+ * @brief Overloads the -= operator for bigint subtraction. Like +=, it works directly from the limbs of rhs: the
+ * order of the magnitudes is decided from their top limbs, then one borrow-propagating pass subtracts the smaller
+ * from the bigger and the sign is set. It only allocates when the result is longer than the capacity of this bigint.
+ *
+ * @param rhs The bigint value to be subtracted. It may be this bigint.
+ * @return A reference to the current bigin.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator-=(const basic_bigint &rhs)
+{
+    add_value(rhs, true);
+    return *this;
+}
+
+/**
+ * @brief Overloads the *= operator for bigint multiplication.
+ *
+ * @param rhs The bigint value to multiply.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator*=(const basic_bigint &rhs)
+{
+    basic_bigint result(get_allocator()); // Same allocator, so that swapping the buffers does not copy them
+    if (this->is_Positive == rhs.is_Positive)
+        result.is_Positive = true;
+    else
+        result.is_Positive = false;
+
+    const size_t n = this->vec.size() + rhs.vec.size();
+    if (n <= 2 * BIGINT_INLINE_LIMBS)
+    {
+        // Short product: computed on the stack, so that a product which fits inline after trimming does not allocate
+        limb_type prod[2 * BIGINT_INLINE_LIMBS];
+        mul_limbs(vec.data(), vec.size(), rhs.vec.data(), rhs.vec.size(), prod);
+        size_t len = n;
+        while (len > 1 && prod[len - 1] == 0)
+        {
+            --len;
+        }
+        vec.assign(prod, prod + len);
+        is_Positive = result.is_Positive;
+        trim(); // Zero is positive
+        return *this;
+    }
+    result.vec.assign(n, 0);
+    // x *= x passes the same limbs twice, so mul_limbs takes the squaring path
+    mul_limbs(vec.data(), vec.size(), rhs.vec.data(), rhs.vec.size(), result.vec.data());
+
+    result.trim();
+    swap(result); // The old limbs are released with result
+    return *this;
+}
+
+/**
+ * @brief Overloads the /= operator for bigint division.
+ *
+ * @param rhs The bigint divisor.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator/=(const basic_bigint &rhs)
+{
+    basic_bigint remainder(get_allocator());
+    divmod(*this, rhs, *this, remainder); // Throws std::invalid_argument if the divisor is 0
+    return *this;
+}
+
+/**
+ * @brief Overloads the %= operator for bigint modulus.
+ *
+ * @param rhs The bigint divisor.
+ * @return A reference to the current bigint object.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator%=(const basic_bigint &rhs)
+{
+    basic_bigint quotient(get_allocator());
+    divmod(*this, rhs, quotient, *this); // The remainder keeps the sign of the dividend, throws if the divisor is 0
+    return *this;
+}
+
+/**
+ * @brief Overloads the prefix ++ operator for bigint.
+ * *
+ * @return A reference to the incremented bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator++()
+{
+    add_native(true, 1);
+    return *this;
+}
+
+/**
+ * @brief Overloads the prefix -- operator for bigint.
+ *
+ * @return A reference to the decremented bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator--()
+{
+    add_native(false, 1);
+    return *this;
+}
+
+/**
+ * @brief Overloads the postfix ++ operator for bigint.
+ * *
+ * @return The value of the bigint before the increment.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::operator++(int)
+{
+    basic_bigint temp(*this, get_allocator());
+    ++(*this);
+    return temp;
+}
+
+/**
+ * @brief Overloads the postfix -- operator for bigint.
+ * *
+ * @return The value of the bigint before the decrement.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::operator--(int)
+{
+    basic_bigint temp(*this, get_allocator());
+    --(*this);
+    return temp;
+}
+
+/**
+ * @brief Adds a native integer to this bigint.
+ *
+ * @param rhs The integer to add.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_detail::native_integer T>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator+=(T rhs)
+{
+    add_native(!bigint_detail::is_negative(rhs), bigint_detail::magnitude(rhs));
+    return *this;
+}
+
+/**
+ * @brief Subtracts a native integer from this bigint.
+ *
+ * @param rhs The integer to subtract.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_detail::native_integer T>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator-=(T rhs)
+{
+    add_native(bigint_detail::is_negative(rhs), bigint_detail::magnitude(rhs));
+    return *this;
+}
+
+/**
+ * @brief Multiplies this bigint by a native integer, with one pass of mul_add_limb.
+ *
+ * @param rhs The integer to multiply by.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_detail::native_integer T>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator*=(T rhs)
+{
+    if (rhs == 0)
+    {
+        assign_native(true, 0);
+        return *this;
+    }
+    mul_add_limb(bigint_detail::magnitude(rhs), 0); // Also right for decimal limbs when the integer is bigger than a limb
+    is_Positive = (is_Positive != bigint_detail::is_negative(rhs));
+    trim();
+    return *this;
+}
+
+/**
+ * @brief Divides this bigint by a native integer, with one pass of div_limb. The quotient is truncated toward zero.
+ *
+ * @param rhs The integer divisor.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_detail::native_integer T>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator/=(T rhs)
+{
+    if (rhs == 0)
+    {
+        throw std::invalid_argument("Cannot divide by zero."); // std::invalid_argument if the division is 0.
+    }
+    div_limb(vec, bigint_detail::magnitude(rhs)); // Also right for decimal limbs when the integer is bigger than a limb
+    is_Positive = (is_Positive != bigint_detail::is_negative(rhs));
+    trim();
+    return *this;
+}
+
+/**
+ * @brief Replaces this bigint by its remainder modulo a native integer. The remainder has the sign of the dividend.
+ *
+ * @param rhs The integer divisor.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_detail::native_integer T>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator%=(T rhs)
+{
+    if (rhs == 0)
+    {
+        throw std::invalid_argument("Cannot divide by zero."); // std::invalid_argument if division by zero
+    }
+    assign_native(is_Positive, mod_limb(vec, bigint_detail::magnitude(rhs)));
+    return *this;
+}
+
+/**
+ * @brief Evaluates a lazy expression into this bigint in one pass. The first term is written into the limb buffer of
+ * this bigint and the other terms are added to it in place.
+ *
+ * @param expr The expression, built by the operators of bigint_expr. It may refer to this bigint.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_expr::expression_of<basic_bigint<Radix, Alloc>> E>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator=(const E &expr)
+{
+    expr.evaluate_into(*this);
+    return *this;
+}
+
+/**
+ * @brief Adds the terms of a lazy expression to this bigint in place, without materializing the expression.
+ *
+ * @param expr The expression, built by the operators of bigint_expr. It may refer to this bigint.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_expr::expression_of<basic_bigint<Radix, Alloc>> E>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator+=(const E &expr)
+{
+    expr.add_into(*this, false);
+    return *this;
+}
+
+/**
+ * @brief Subtracts the terms of a lazy expression from this bigint in place, without materializing the expression.
+ *
+ * @param expr The expression, built by the operators of bigint_expr. It may refer to this bigint.
+ * @return A reference to the current bigint.
+ */
+template <uint64_t Radix, typename Alloc>
+template <bigint_expr::expression_of<basic_bigint<Radix, Alloc>> E>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator-=(const E &expr)
+{
+    expr.add_into(*this, true);
+    return *this;
+}
+
+/**
+ * @brief Assigns a native integer, given as a sign and a magnitude, without reallocating the limbs.
+ *
+ * @param positive The sign, ignored for zero.
+ * @param m The magnitude.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::assign_native(bool positive, uint64_t m)
+{
+    vec.clear();
+    if constexpr (is_binary)
+    {
+        vec.push_back(m);
+    }
+    else
+    {
+        do
+        {
+            vec.push_back(m % Radix);
+            m /= Radix;
+        } while (m > 0);
+    }
+    is_Positive = positive;
+    trim();
+}
+
+/**
+ * @brief Adds a native integer, given as a sign and a magnitude.
+ *
+ * The magnitude fits in one limb (always for binary limbs), so the carry or the borrow only runs as far as it
+ * propagates. A magnitude bigger than a decimal limb takes the general addition.
+ *
+ * @param positive The sign of the integer.
+ * @param m The magnitude of the integer.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::add_native(bool positive, uint64_t m)
+{
+    if (m == 0)
+    {
+        return;
+    }
+    if constexpr (!is_binary)
+    {
+        if (m >= Radix)
+        {
+            basic_bigint temp(get_allocator());
+            temp.assign_native(positive, m);
+            *this += temp;
+            return;
+        }
+    }
+
+    if (is_Positive == positive) // Same signs: add the magnitudes
+    {
+        limb_type carry = 0;
+        vec[0] = add_limbs(vec[0], m, carry);
+        for (size_t i = 1; carry && i < vec.size(); ++i)
+        {
+            vec[i] = add_limbs(vec[i], 0, carry);
+        }
+        if (carry)
+        {
+            vec.push_back(carry);
+        }
+    }
+    else if (vec.size() == 1 && vec[0] < m) // The integer is bigger: the sign changes
+    {
+        vec[0] = m - vec[0];
+        is_Positive = positive;
+    }
+    else // Subtract the magnitudes
+    {
+        limb_type borrow = 0;
+        vec[0] = sub_limbs(vec[0], m, borrow);
+        for (size_t i = 1; borrow; ++i)
+        {
+            vec[i] = sub_limbs(vec[i], 0, borrow);
+        }
+        trim();
+    }
+}
+
+/**
+ * @brief Compares this bigint with a native integer, given as a sign and a magnitude.
+ *
+ * @param positive The sign of the integer.
+ * @param m The magnitude of the integer.
+ * @return A negative value, 0 or a positive value if this bigint is smaller, equal or bigger.
+ */
+template <uint64_t Radix, typename Alloc>
+int basic_bigint<Radix, Alloc>::compare_native(bool positive, uint64_t m) const
+{
+    if (m == 0)
+    {
+        positive = true; // Zero is positive, like in trim()
+    }
+    if (is_Positive != positive)
+    {
+        return is_Positive ? 1 : -1;
+    }
+    int magnitude_order;
+    if constexpr (!is_binary)
+    {
+        if (m >= Radix) // The integer takes more than one limb
+        {
+            basic_bigint temp(get_allocator());
+            temp.assign_native(true, m);
+            magnitude_order = cmp_n(vec.data(), vec.size(), temp.vec.data(), temp.vec.size());
+            return is_Positive ? magnitude_order : -magnitude_order;
+        }
+    }
+    magnitude_order = vec.size() > 1 ? 1 : (vec[0] > m) - (vec[0] < m);
+    return is_Positive ? magnitude_order : -magnitude_order;
+}
+
+/**
+ * @brief Adds a signed magnitude given as raw limbs to this bigint in place. The limbs of this bigint are only
+ * reallocated when the sum is longer than their capacity.
+ *
+ * @param p The trimmed magnitude to add. It must not point into the limbs of this bigint.
+ * @param n The number of limbs of p, at least 1.
+ * @param positive The sign of the value to add.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::add_signed(const limb_type *p, size_t n, bool positive)
+{
+    const size_t vn = vec.size();
+    if (is_Positive == positive) // Same sign: add the magnitudes
+    {
+        if (vn < n)
+        {
+            vec.resize(n, 0);
+        }
+        limb_type carry = add_n(vec.data(), vec.data(), n, p, n);
+        for (size_t i = n; i < vec.size() && carry > 0; ++i)
+        {
+            vec[i] = add_limbs(vec[i], 0, carry);
+        }
+        if (carry > 0)
+        {
+            vec.push_back(carry);
+        }
+    }
+    else if (cmp_n(vec.data(), vn, p, n) >= 0) // The magnitude of this bigint decreases, the sign stays
+    {
+        limb_type borrow = sub_n(vec.data(), vec.data(), n, p, n);
+        for (size_t i = n; borrow > 0; ++i)
+        {
+            vec[i] = sub_limbs(vec[i], 0, borrow);
+        }
+    }
+    else // The sign changes: vec = p - vec
+    {
+        vec.resize(n, 0);
+        sub_n(vec.data(), p, n, vec.data(), n);
+        is_Positive = positive;
+    }
+    trim();
+}
+
+/**
+ * @brief Adds or subtracts a bigint in place.
+ *
+ * @param x The value to add. It may be this bigint.
+ * @param negate Whether x is subtracted instead.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::add_value(const basic_bigint &x, bool negate)
+{
+    if (&x != this)
+    {
+        add_signed(x.vec.data(), x.vec.size(), x.is_Positive != negate);
+    }
+    else if (negate) // x - x
+    {
+        assign_native(true, 0);
+    }
+    else // x + x
+    {
+        mul_add_limb(2, 0);
+    }
+}
+
+/**
+ * @brief Adds or subtracts a product in place, without a temporary bigint. When one factor is shorter than
+ * BIGINT_KARATSUBA_THRESHOLD limbs the product is accumulated row by row with add_rows, otherwise (and when the
+ * factors alias this bigint or each other, a square) it is computed in the scratch space of the thread and added
+ * from there.
+ *
+ * @param x The first factor. It may be this bigint.
+ * @param y The second factor. It may be this bigint.
+ * @param negate Whether the product is subtracted instead.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::add_product(const basic_bigint &x, const basic_bigint &y, bool negate)
+{
+    const bool positive = (x.is_Positive == y.is_Positive) != negate;
+    if (&x != this && &y != this && &x != &y && std::min(x.vec.size(), y.vec.size()) < BIGINT_KARATSUBA_THRESHOLD)
+    {
+        if (x.vec.size() >= y.vec.size())
+        {
+            add_rows(x.vec.data(), x.vec.size(), y.vec.data(), y.vec.size(), positive);
+        }
+        else
+        {
+            add_rows(y.vec.data(), y.vec.size(), x.vec.data(), x.vec.size(), positive);
+        }
+        return;
+    }
+    bigint_detail::scratch_frame frame;
+    size_t n = x.vec.size() + y.vec.size();
+    limb_type *prod = frame.take(n);
+    mul_limbs(x.vec.data(), x.vec.size(), y.vec.data(), y.vec.size(), prod);
+    while (n > 1 && prod[n - 1] == 0)
+    {
+        --n;
+    }
+    add_signed(prod, n, positive);
+}
+
+/**
+ * @brief Adds or subtracts the product of a bigint and a native integer in place, in one sweep over the limbs of x.
+ *
+ * @param x The bigint factor. It may be this bigint.
+ * @param positive The sign of the integer factor.
+ * @param m The magnitude of the integer factor.
+ * @param negate Whether the product is subtracted instead.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::add_product_native(const basic_bigint &x, bool positive, uint64_t m, bool negate)
+{
+    limb_type limbs[64]; // m in limbs: one binary limb, or up to 20 decimal limbs
+    size_t mn = 0;
+    do
+    {
+        if constexpr (is_binary)
+        {
+            limbs[mn++] = m;
+            m = 0;
+        }
+        else
+        {
+            limbs[mn++] = m % Radix;
+            m /= Radix;
+        }
+    } while (m > 0);
+    positive = (x.is_Positive == positive) != negate;
+    if (&x != this)
+    {
+        add_rows(x.vec.data(), x.vec.size(), limbs, mn, positive);
+        return;
+    }
+    bigint_detail::scratch_frame frame; // acc += acc * m reads the limbs it writes, so they are copied first
+    limb_type *copy = frame.take(vec.size());
+    std::copy(vec.begin(), vec.end(), copy);
+    add_rows(copy, vec.size(), limbs, mn, positive);
+}
 
 /**
- * @brief Initializes static member variables.
+ * @brief Adds a signed product in place, one row of addmul_1 (or submul_1) per limb of b, so that no limb of the
+ * product is stored anywhere but in this bigint.
+ *
+ * The limbs are extended to hold the product. Subtracting works modulo base^len: when the product is bigger than
+ * this bigint, the last borrow leaves the top limb, and the magnitude is the complement of the limbs.
+ *
+ * @param a The first factor, an limbs. It must not point into the limbs of this bigint.
+ * @param an The number of limbs of a.
+ * @param b The second factor, bn limbs, bn <= an. It must not point into the limbs of this bigint.
+ * @param bn The number of limbs of b.
+ * @param positive The sign of the product.
  */
-
-const bigint bigint::s_zero = bigint(0);
-const bigint bigint::s_one = bigint(1);
-const bigint bigint::s_two = bigint(2);
-const bigint bigint::s_ten = bigint(10);
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::add_rows(const limb_type *a, size_t an, const limb_type *b, size_t bn, bool positive)
+{
+    if (vec.size() == 1 && vec[0] == 0)
+    {
+        is_Positive = positive; // 0 - a * b is an addition
+    }
+    if (vec.size() < an + bn)
+    {
+        vec.resize(an + bn, 0);
+    }
+    limb_type *r = vec.data();
+    const size_t len = vec.size();
+    limb_type out = 0; // Carry (or borrow) out of the top limb, the sum is below 2 base^len
+    if (is_Positive == positive)
+    {
+        for (size_t j = 0; j < bn; ++j)
+        {
+            limb_type carry = addmul_1(r + j, a, an, b[j]);
+            for (size_t i = j + an; i < len && carry > 0; ++i)
+            {
+                limb_type next = 0;
+                r[i] = add_limbs(r[i], carry, next);
+                carry = next;
+            }
+            out += carry;
+        }
+    }
+    else
+    {
+        for (size_t j = 0; j < bn; ++j)
+        {
+            limb_type borrow = submul_1(r + j, a, an, b[j]);
+            for (size_t i = j + an; i < len && borrow > 0; ++i)
+            {
+                limb_type next = 0;
+                r[i] = sub_limbs(r[i], borrow, next);
+                borrow = next;
+            }
+            out += borrow;
+        }
+        if (out > 0) // The product was bigger: the magnitude is base^len - r, with the sign of the product
+        {
+            limb_type borrow = 0;
+            for (size_t i = 0; i < len; ++i)
+            {
+                r[i] = sub_limbs(0, r[i], borrow);
+            }
+            is_Positive = positive;
+            out = 0;
+        }
+    }
+    if (out > 0)
+    {
+        vec.push_back(out);
+    }
+    trim();
+}
 
 /**
- * @brief Default constructor for bigint. Initializes the bigint to zero with a positive sign.
+ * @brief Assigns a product, computed in the scratch space of the thread and copied into the limb buffer of this
+ * bigint, which is only reallocated when it is too small.
  *
+ * @param x The first factor. It may be this bigint.
+ * @param y The second factor. It may be this bigint.
  */
-bigint::bigint()
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::assign_product(const basic_bigint &x, const basic_bigint &y)
 {
-    // vec.clear();
-    vec.push_back(0);
-    is_Positive = true;
+    bigint_detail::scratch_frame frame;
+    size_t n = x.vec.size() + y.vec.size();
+    limb_type *prod = frame.take(n);
+    mul_limbs(x.vec.data(), x.vec.size(), y.vec.data(), y.vec.size(), prod);
+    while (n > 1 && prod[n - 1] == 0)
+    {
+        --n;
+    }
+    is_Positive = (x.is_Positive == y.is_Positive);
+    vec.assign(prod, prod + n);
+    trim(); // Zero is positive
 }
 
 /**
- * @brief Constructs a bigint from a 64-bit integer.
+ * @brief Computes the magnitude stored in v modulo a single integer, without changing v.
  *
- * @param a The 64-bit integer, initializing the bigint.
+ * @param v The limbs.
+ * @param div The divisor, not zero. For decimal limbs it may be bigger than a limb.
+ * @return The remainder.
  */
+template <uint64_t Radix, typename Alloc>
+uint64_t basic_bigint<Radix, Alloc>::mod_limb(const limb_vector &v, uint64_t div)
+{
+    uint64_t rem = 0;
+    for (size_t i = v.size(); i-- > 0;)
+    {
+        double_limb_type cur;
+        if constexpr (is_binary)
+        {
+            cur = (static_cast<double_limb_type>(rem) << limb_bits) | v[i];
+        }
+        else
+        {
+            cur = static_cast<double_limb_type>(rem) * Radix + v[i];
+        }
+        rem = static_cast<uint64_t>(cur % div);
+    }
+    return rem;
+}
 
-bigint::bigint(const int64_t &a)
+/**
+ * @brief Overloads the unary + operator for bigint.
+ * *
+ * @return A reference to the current bigint object.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> &basic_bigint<Radix, Alloc>::operator+()
 {
-    vec.clear();
-    vec.reserve(20); // Reserve vec for efficiency.
+    return *this;
+}
 
-    if (a >= 0)
+/**
+ * @brief Overloads the unary - operator for bigint.
+ * *
+ * @return A bigint with the opposite sign.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::operator-() const &
+{
+    basic_bigint ret(*this, get_allocator());
+    // Avoid bigint a('0') output '-0' error, tested by test.
+    if (ret.vec.size() == 1 && ret.vec[0] == 0)
     {
-        is_Positive = true;
+        ret.is_Positive = true;
     }
     else
     {
-        is_Positive = false;
+        ret.is_Positive = !ret.is_Positive;
     }
-    // If the value is zero, store it and exit
-    if (a == 0)
+    return ret;
+}
+
+/**
+ * @brief Overloads the unary - operator for a temporary bigint, whose limbs are reused.
+ *
+ * @return A bigint with the opposite sign.
+ */
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::operator-() &&
+{
+    if (vec.size() > 1 || vec[0] != 0) // Zero stays positive
     {
-        vec.push_back(0);
-        return;
+        is_Positive = !is_Positive;
     }
+    return std::move(*this);
+}
 
-    // use uint64_t to handle the negative number to avoid overflow of int64_t
-    uint64_t temp_val;
-    if (a == INT64_MIN)
+/**
+ * @brief Adds two limbs and the incoming carry.
+ *
+ * @param a The first limb.
+ * @param b The second limb.
+ * @param carry The incoming carry (0 or 1), replaced by the outgoing carry.
+ * @return The low limb of the sum.
+ */
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::add_limbs(limb_type a, limb_type b, limb_type &carry)
+{
+    if constexpr (is_binary)
     {
-        temp_val = static_cast<uint64_t>(INT64_MAX) + 1;
+        return bigint_detail::add_carry(a, b, carry);
     }
     else
     {
-        if (a >= 0)
-        {
-            temp_val = static_cast<uint64_t>(a);
-        }
-        else
-        {
-            temp_val = static_cast<uint64_t>(-a);
-        }
+        // Radix <= 10^19, so 2 * Radix - 1 still fits in a limb
+        limb_type sum = a + b + carry;
+        carry = (sum >= Radix) ? 1 : 0;
+        return carry ? sum - Radix : sum;
     }
+}
 
-    // Extract each digit and store it in vec
-    while (temp_val > 0)
+/**
+ * @brief Subtracts a limb and the incoming borrow from another limb.
+ *
+ * @param a The limb to subtract from.
+ * @param b The limb to subtract.
+ * @param borrow The incoming borrow (0 or 1), replaced by the outgoing borrow.
+ * @return The low limb of the difference.
+ */
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::sub_limbs(limb_type a, limb_type b, limb_type &borrow)
+{
+    if constexpr (is_binary)
     {
-        uint8_t t = static_cast<uint8_t>(temp_val % 10);
-        vec.push_back(t);
-        temp_val /= 10;
+        return bigint_detail::sub_borrow(a, b, borrow);
     }
+    limb_type diff = a - b - borrow; // Wraps around modulo 2^64 when a borrow is needed
+    limb_type out = (a < b || a - b < borrow) ? 1 : 0;
+    borrow = out;
+    if (out)
+    {
+        diff += Radix; // Borrow 1 from the higher limb: add Radix to the current limb
+    }
+    return diff;
 }
 
 /**
- * @brief Constructs a bigint from a string.
+ * @brief Multiplies two limbs and adds a limb and the incoming carry.
  *
- * @param str The string used to initialize the bigint.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @param add The limb to add.
+ * @param carry The incoming carry, replaced by the outgoing carry.
+ * @return The low limb of the result.
  */
-bigint::bigint(const std::string &str)
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::mul_add_limbs(limb_type a, limb_type b, limb_type add, limb_type &carry)
 {
-    // check wether the str is empty.
-    if (str.empty())
+    // (base - 1)^2 + 2 * (base - 1) = base^2 - 1 still fits in 128 bits
+    double_limb_type cur = static_cast<double_limb_type>(a) * b + add + carry;
+    if constexpr (is_binary)
     {
-        throw std::invalid_argument("Input string is empty"); // std::invalid_argument: If the string is empty.
+        carry = static_cast<limb_type>(cur >> limb_bits);
+        return static_cast<limb_type>(cur);
     }
-    vec.clear();
-    vec.reserve(str.length());
-    is_Positive = true;
-    size_t temp = 0;
-    if (str[0] == '-')
+    else
     {
-        is_Positive = false;
-        temp = 1; // The indicator for skipping the '-'.
+        carry = static_cast<limb_type>(cur / Radix);
+        return static_cast<limb_type>(cur % Radix);
     }
-    if (str.length() == temp)
+}
+
+/**
+ * @brief Adds two limb arrays: r = a + b.
+ *
+ * @param r The result, an limbs long. It may be the same array as a.
+ * @param a The longer operand.
+ * @param an The number of limbs of a.
+ * @param b The shorter operand.
+ * @param bn The number of limbs of b, bn <= an.
+ * @return The carry out of the most significant limb.
+ */
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::add_n(limb_type *r, const limb_type *a, size_t an, const limb_type *b, size_t bn)
+{
+    limb_type carry = 0;
+    size_t i = 0;
+    if constexpr (is_binary)
     {
-        throw std::invalid_argument("Input string is only '-' or empty"); // std::invalid_argument: If the string is '-'.
+        carry = bigint_detail::add_words(r, a, b, bn);
+        i = bn;
     }
-
-    for (size_t i = str.length(); i-- > temp;)
+    for (; i < bn; ++i)
     {
-        if (!std::isdigit(str[i]))
-        {
-            throw std::invalid_argument("Input string contains non-digit character"); // std::invalid_argument: If the string contains non-digit character.
-        }
-        vec.push_back(static_cast<uint8_t>(str[i] - '0'));
+        r[i] = add_limbs(a[i], b[i], carry);
     }
-    trim();
+    for (; i < an; ++i)
+    {
+        r[i] = add_limbs(a[i], 0, carry);
+    }
+    return carry;
 }
 
 /**
- * @brief Copy constructor for bigint.
+ * @brief Subtracts two limb arrays: r = a - b.
  *
- * @param a This is bigint object which be copied.
+ * @param r The result, an limbs long. It may be the same array as a or as b, each limb is read before it is written.
+ * @param a The operand to subtract from.
+ * @param an The number of limbs of a.
+ * @param b The operand to subtract.
+ * @param bn The number of limbs of b, bn <= an.
+ * @return The borrow out of the most significant limb, 0 when a >= b.
  */
-bigint::bigint(const bigint &a)
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::sub_n(limb_type *r, const limb_type *a, size_t an, const limb_type *b, size_t bn)
 {
-    vec.clear();
-    if (a.is_Positive == true)
+    limb_type borrow = 0;
+    size_t i = 0;
+    if constexpr (is_binary)
     {
-        is_Positive = true;
+        borrow = bigint_detail::sub_words(r, a, b, bn);
+        i = bn;
     }
-    else
+    for (; i < bn; ++i)
     {
-        is_Positive = false;
+        r[i] = sub_limbs(a[i], b[i], borrow);
     }
-    vec.reserve(a.vec.size());
-    for (size_t i = 0; i < a.vec.size(); ++i)
+    for (; i < an; ++i)
     {
-        vec.push_back(a.vec[i]); // Copy each digit from the source bigint
+        r[i] = sub_limbs(a[i], 0, borrow);
     }
+    return borrow;
 }
 
 /**
- * @brief Overloaded assignment operator for bigint.
+ * @brief Compares two trimmed limb arrays.
  *
- * @param a The bigint to be assigned.
- * @return A reference to the current bigint.
+ * @param a The first operand.
+ * @param an The number of limbs of a.
+ * @param b The second operand.
+ * @param bn The number of limbs of b.
+ * @return A negative value, 0 or a positive value if a is smaller, equal or bigger than b.
  */
-bigint &bigint::operator=(const bigint &a)
+template <uint64_t Radix, typename Alloc>
+int basic_bigint<Radix, Alloc>::cmp_n(const limb_type *a, size_t an, const limb_type *b, size_t bn)
 {
+    if (an != bn)
+    {
+        return an > bn ? 1 : -1;
+    }
+    return bigint_detail::cmp_words(a, b, an); // Limbs compare as words in every radix
+}
 
-    bigint temp(a);
-    vec.clear();
-    is_Positive = temp.is_Positive; // Align the sign.
+/**
+ * @brief Adds a limb array multiplied by a single limb: r += a * q.
+ *
+ * @param r The accumulator, n limbs.
+ * @param a The multiplicand, n limbs.
+ * @param n The number of limbs.
+ * @param q The multiplier limb.
+ * @return The limb to add to r[n].
+ */
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::addmul_1(limb_type *r, const limb_type *a, size_t n, limb_type q)
+{
+    limb_type carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        r[i] = mul_add_limbs(a[i], q, r[i], carry);
+    }
+    return carry;
+}
 
-    for (size_t i = 0; i < temp.vec.size(); ++i)
+/**
+ * @brief Schoolbook multiplication: res = a * b, one row of mul_add_limbs per limb of a.
+ *
+ * @param a The first factor.
+ * @param an The number of limbs of a.
+ * @param b The second factor.
+ * @param bn The number of limbs of b.
+ * @param res The result, an + bn limbs. It must not overlap a or b.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::mul_basecase(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res)
+{
+    std::fill(res, res + an + bn, 0);
+    for (size_t i = 0; i < an; ++i)
     {
-        vec.push_back(temp.vec[i]); // Copy each digit from the source bigint
+        limb_type temp = 0; // Carry of the current row
+        for (size_t j = 0; j < bn; ++j)
+        {
+            res[i + j] = mul_add_limbs(a[i], b[j], res[i + j], temp); // Store the low limb, keep the carry
+        }
+        res[i + bn] = temp;
     }
-    trim();
-    return *this;
 }
 
 /**
- * @brief Assigns an int64_t value to the bigint.
+ * @brief Schoolbook squaring: res = a * a.
  *
- * @param a The 64-bit integer to be assigned.
- * @return A reference to the current bigint.
+ * The cross products a[i] * a[j] with i < j appear twice in the square, so they are computed once and doubled,
+ * then the diagonal squares a[i] * a[i] are added. This is about half the work of mul_basecase(a, n, a, n, res).
+ *
+ * @param a The number to square.
+ * @param n The number of limbs of a.
+ * @param res The result, 2n limbs. It must not overlap a.
  */
-bigint &bigint::operator=(const int64_t &a)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::sqr_basecase(const limb_type *a, size_t n, limb_type *res)
 {
-    bigint temp(a);
-    *this = temp;
-    trim();
-    return *this;
+    std::fill(res, res + 2 * n, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        limb_type temp = 0;
+        for (size_t j = i + 1; j < n; ++j)
+        {
+            res[i + j] = mul_add_limbs(a[i], a[j], res[i + j], temp);
+        }
+        res[i + n] = temp;
+    }
+    add_n(res, res, 2 * n, res, 2 * n); // Double the cross products, it cannot carry out since the square fits
+
+    limb_type carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        limb_type high = 0;
+        limb_type low = mul_add_limbs(a[i], a[i], 0, high);
+        res[2 * i] = add_limbs(res[2 * i], low, carry);
+        res[2 * i + 1] = add_limbs(res[2 * i + 1], high, carry);
+    }
 }
 
 /**
- * @brief Assigns a string value to this bigint.
+ * @brief Bounds the scratch words taken by mul_karatsuba on operands of n limbs: 4m + 4 words at each level, where
+ * m = ceil(n / 2), then the recursion on operands of m + 1 limbs. Reserving them at once keeps the buffers of the
+ * whole recursion in one block of the scratch stack.
  *
- * @param str The string which will be assigned to the bigint.
- * @return A reference to the current bigint.
+ * @param n The number of limbs of the longer operand.
+ * @return The number of words.
  */
-bigint &bigint::operator=(const std::string &str)
+template <uint64_t Radix, typename Alloc>
+constexpr size_t basic_bigint<Radix, Alloc>::karatsuba_scratch(size_t n)
 {
-    if (str.empty())
+    size_t words = 0;
+    while (n >= static_cast<size_t>(std::min(BIGINT_KARATSUBA_THRESHOLD, BIGINT_SQR_KARATSUBA_THRESHOLD)))
     {
-        throw std::invalid_argument("Input string is empty"); // std::invalid_argument If the string is empty
+        const size_t m = (n + 1) / 2;
+        words += 4 * m + 4;
+        n = m + 1;
     }
-    vec.clear();
-    vec.reserve(str.length());
-    size_t temp = 0;
-    is_Positive = true;
-    if (str[0] == '-')
+    return words;
+}
+
+/**
+ * @brief Karatsuba multiplication of two operands of similar size, an >= bn > (an + 1) / 2.
+ *
+ * With a = a1 * B^m + a0 and b = b1 * B^m + b0, the product needs only three half-size products:
+ * z0 = a0 * b0, z2 = a1 * b1 and z1 = (a0 + a1) * (b0 + b1) - z0 - z2, so that a * b = z2 * B^2m + z1 * B^m + z0.
+ * The half-size products go through mul_limbs again, so the recursion ends in mul_basecase.
+ * When a and b are the same array, all three products are squares.
+ *
+ * @param a The first factor.
+ * @param an The number of limbs of a.
+ * @param b The second factor.
+ * @param bn The number of limbs of b.
+ * @param res The result, an + bn limbs. It must not overlap a or b.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::mul_karatsuba(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res)
+{
+    const size_t m = (an + 1) / 2; // Size of the low halves a0 and b0
+    const size_t a1n = an - m;
+    const size_t b1n = bn - m;
+
+    // z0 goes to the low part of res and z2 to the high part, they do not overlap
+    mul_limbs(a, m, b, m, res);
+    mul_limbs(a + m, a1n, b + m, b1n, res + 2 * m);
+
+    // sa = a0 + a1 and sb = b0 + b1, each with one extra limb for the carry, in the scratch stack
+    const bool square = (a == b && an == bn);
+    bigint_detail::scratch_frame frame;
+    frame.reserve(karatsuba_scratch(an));
+    limb_type *sa = frame.take(m + 1), *sb = square ? sa : frame.take(m + 1), *z1 = frame.take(2 * m + 2);
+    sa[m] = add_n(sa, a, m, a + m, a1n);
+    if (!square)
     {
-        is_Positive = false;
-        temp = 1;
+        sb[m] = add_n(sb, b, m, b + m, b1n);
     }
+    mul_limbs(sa, m + 1, sb, m + 1, z1);
 
-    if (str.length() == temp)
+    // z1 = sa * sb - z0 - z2, which is never negative
+    sub_n(z1, z1, 2 * m + 2, res, 2 * m);
+    sub_n(z1, z1, 2 * m + 2, res + 2 * m, a1n + b1n);
+
+    // Add z1 * B^m into the result. Its top limbs are zero once it is past the end of res.
+    size_t z1n = 2 * m + 2;
+    while (z1n > 0 && z1[z1n - 1] == 0)
     {
-        throw std::invalid_argument("Input string is only '-' or empty"); // std::invalid_argument If the string is only '-'.
+        --z1n;
     }
+    add_n(res + m, res + m, an + bn - m, z1, z1n);
+}
 
-    size_t i = str.length() - 1; // initialize i to start from last.
-    // Extract each character from the string and store its value in vec
-    while (i >= temp)
+/**
+ * @brief Multiplies two limb arrays with the algorithm that suits their sizes.
+ *
+ * Operands below BIGINT_KARATSUBA_THRESHOLD limbs use schoolbook multiplication. A much longer first operand is cut
+ * into pieces as long as the second one, so that every Karatsuba call gets operands of similar size.
+ * When a and b are the same array the product is a square: schoolbook squaring is used below
+ * BIGINT_SQR_KARATSUBA_THRESHOLD limbs, and the other algorithms reuse the evaluations of a for b.
+ *
+ * @param a The first factor.
+ * @param an The number of limbs of a.
+ * @param b The second factor.
+ * @param bn The number of limbs of b.
+ * @param res The result, an + bn limbs. It must not overlap a or b.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::mul_limbs(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res)
+{
+    if (an < bn) // Keep the longer operand first
     {
-        if (!std::isdigit(str[i]))
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+    if (a == b && an == bn && an < BIGINT_SQR_KARATSUBA_THRESHOLD)
+    {
+        sqr_basecase(a, an, res);
+        return;
+    }
+    if (bn < BIGINT_KARATSUBA_THRESHOLD)
+    {
+        mul_basecase(a, an, b, bn, res);
+        return;
+    }
+    if (bn >= BIGINT_FFT_THRESHOLD && fft_fits(an, bn)) // The transform handles unbalanced operands by itself
+    {
+        mul_fft(a, an, b, bn, res);
+        return;
+    }
+    if (2 * bn <= an) // Unbalanced: multiply b by each bn-limb piece of a and add the partial products
+    {
+        std::fill(res, res + an + bn, 0);
+        bigint_detail::scratch_frame frame;
+        limb_type *part = frame.take(2 * bn);
+        for (size_t i = 0; i < an; i += bn)
         {
-            throw std::invalid_argument("Input string contains non-digit character"); // std::invalid_argument If the string contains any non-digit characters.
+            size_t len = std::min(bn, an - i);
+            mul_limbs(a + i, len, b, bn, part);
+            add_n(res + i, res + i, an + bn - i, part, len + bn);
         }
-        vec.push_back(static_cast<uint8_t>(str[i] - '0'));
+        return;
+    }
+    if (bn < BIGINT_TOOM3_THRESHOLD)
+    {
+        mul_karatsuba(a, an, b, bn, res);
+    }
+    else if (bn < BIGINT_TOOM4_THRESHOLD)
+    {
+        mul_toom3(a, an, b, bn, res);
+    }
+    else
+    {
+        mul_toom4(a, an, b, bn, res);
+    }
+}
 
-        if (i == temp) // Avoid size_t underflow
+/**
+ * @brief Toom-Cook 3-way multiplication of two operands of similar size, an >= bn > an / 2.
+ *
+ * a and b are split into three pieces of m limbs, read as polynomials a(x) = a0 + a1 x + a2 x^2 with x = B^m.
+ * The product c(x) = c0 + c1 x + ... + c4 x^4 is evaluated at 0, 1, -1, 2 and infinity with five recursive
+ * products of m limbs, then the coefficients are interpolated back:
+ * c0 = r(0), c4 = r(inf), c2 = (r(1) + r(-1)) / 2 - c0 - c4, c1 + c3 = (r(1) - r(-1)) / 2 and
+ * c1 + 4 c3 = (r(2) - c0 - 4 c2 - 16 c4) / 2. All the divisions are exact.
+ *
+ * @param a The first factor.
+ * @param an The number of limbs of a.
+ * @param b The second factor.
+ * @param bn The number of limbs of b.
+ * @param res The result, an + bn limbs. It must not overlap a or b.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::mul_toom3(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res)
+{
+    const size_t m = (an + 2) / 3;
+    const bool square = (a == b && an == bn); // b is not split nor evaluated, the products are squares
+    basic_bigint x[3], y[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+        size_t a_begin = std::min(i * m, an), b_begin = std::min(i * m, bn);
+        x[i] = from_limbs(a + a_begin, std::min(m, an - a_begin));
+        if (!square)
         {
-            break;
+            y[i] = from_limbs(b + b_begin, std::min(m, bn - b_begin));
         }
-        --i;
     }
 
-    trim();
-    return *this;
+    // Evaluation at 1, -1 and 2 (Horner form: (x2 * 2 + x1) * 2 + x0)
+    auto evaluate = [](const basic_bigint (&p)[3], basic_bigint (&v)[3])
+    {
+        basic_bigint even = p[0] + p[2];
+        v[0] = even + p[1];
+        v[1] = even - p[1];
+        v[2] = p[2];
+        v[2].mul_add_limb(2, 0);
+        v[2] += p[1];
+        v[2].mul_add_limb(2, 0);
+        v[2] += p[0];
+    };
+    basic_bigint va[3], vb[3];
+    evaluate(x, va);
+    if (!square)
+    {
+        evaluate(y, vb);
+    }
+    const basic_bigint(&yb)[3] = square ? x : y;
+    const basic_bigint(&wb)[3] = square ? va : vb;
+
+    // Pointwise products
+    basic_bigint c0 = mul_signed(x[0], yb[0]);
+    basic_bigint c4 = mul_signed(x[2], yb[2]);
+    basic_bigint r_p1 = mul_signed(va[0], wb[0]);
+    basic_bigint r_m1 = mul_signed(va[1], wb[1]);
+    basic_bigint r_p2 = mul_signed(va[2], wb[2]);
+
+    // Interpolation
+    basic_bigint c2 = r_p1 + r_m1;
+    div_exact(c2, 2);
+    c2 -= c0;
+    c2 -= c4;
+    basic_bigint odd = r_p1 - r_m1; // c1 + c3
+    div_exact(odd, 2);
+    basic_bigint c3 = c2;
+    c3.mul_add_limb(4, 0);
+    basic_bigint w = c4;
+    w.mul_add_limb(16, 0);
+    w += c3;
+    w += c0;
+    c3 = r_p2 - w; // 2 c1 + 8 c3
+    div_exact(c3, 2);
+    c3 -= odd; // 3 c3
+    div_exact(c3, 3);
+    basic_bigint c1 = odd - c3;
+
+    // Recomposition: every coefficient is non-negative and they are added at multiples of m limbs
+    std::fill(res, res + an + bn, 0);
+    add_shifted(res, an + bn, c0, 0);
+    add_shifted(res, an + bn, c1, m);
+    add_shifted(res, an + bn, c2, 2 * m);
+    add_shifted(res, an + bn, c3, 3 * m);
+    add_shifted(res, an + bn, c4, 4 * m);
 }
 
 /**
- * @brief Returns the representation of the string of the bigint.
+ * @brief Toom-Cook 4-way multiplication of two operands of similar size, an >= bn > an / 2.
  *
- * @return A string representing the bigint.
+ * a and b are split into four pieces of m limbs, so the product c(x) = c0 + c1 x + ... + c6 x^6 needs seven
+ * recursive products of m limbs, at the points 0, 1, -1, 2, -2, 3 and infinity. The symmetric points give the
+ * even and odd parts of c(x) separately:
+ * (r(1) + r(-1)) / 2 = c0 + c2 + c4 + c6 and (r(2) + r(-2)) / 2 = c0 + 4 c2 + 16 c4 + 64 c6 give c2 and c4,
+ * (r(1) - r(-1)) / 2 = c1 + c3 + c5, (r(2) - r(-2)) / 4 = c1 + 4 c3 + 16 c5 and r(3) give c1, c3 and c5.
+ * All the divisions are exact.
+ *
+ * @param a The first factor.
+ * @param an The number of limbs of a.
+ * @param b The second factor.
+ * @param bn The number of limbs of b.
+ * @param res The result, an + bn limbs. It must not overlap a or b.
  */
-std::string bigint::get_value() const
-{
-    if (vec.empty())
-    {
-        throw std::invalid_argument("vec is empty, invalid for bigint."); // std::invalid_argument If the internal vector `vec` is empty.
-    }
-    std::string a;
-    if (!is_Positive)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::mul_toom4(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res)
+{
+    const size_t m = (an + 3) / 4;
+    const bool square = (a == b && an == bn); // b is not split nor evaluated, the products are squares
+    basic_bigint x[4], y[4];
+    for (size_t i = 0; i < 4; ++i)
     {
-        a = "-";
+        size_t a_begin = std::min(i * m, an), b_begin = std::min(i * m, bn);
+        x[i] = from_limbs(a + a_begin, std::min(m, an - a_begin));
+        if (!square)
+        {
+            y[i] = from_limbs(b + b_begin, std::min(m, bn - b_begin));
+        }
     }
 
-    // find the first non-zero position
-    size_t i = vec.size() - 1;
-    while (i > 0 && vec[i] == 0)
+    // Evaluates one operand at 1, -1, 2, -2 and 3
+    auto evaluate = [](const basic_bigint (&p)[4], basic_bigint (&v)[5])
     {
-        --i;
-    }
-
-    // Append each digit from vec to the result string
-    for (size_t j = i; j > 0; --j)
+        basic_bigint even = p[0] + p[2], odd = p[1] + p[3];
+        v[0] = even + odd;
+        v[1] = even - odd;
+        basic_bigint even2 = p[2], odd2 = p[3];
+        even2.mul_add_limb(4, 0);
+        even2 += p[0]; // p0 + 4 p2
+        odd2.mul_add_limb(4, 0);
+        odd2 += p[1];
+        odd2.mul_add_limb(2, 0); // 2 p1 + 8 p3
+        v[2] = even2 + odd2;
+        v[3] = even2 - odd2;
+        v[4] = p[3]; // Horner form: ((p3 * 3 + p2) * 3 + p1) * 3 + p0
+        for (size_t i = 3; i-- > 0;)
+        {
+            v[4].mul_add_limb(3, 0);
+            v[4] += p[i];
+        }
+    };
+    basic_bigint va[5], vb[5];
+    evaluate(x, va);
+    if (!square)
     {
-        a += static_cast<char>('0' + static_cast<unsigned>(vec[j]));
+        evaluate(y, vb);
     }
-    a += static_cast<char>('0' + static_cast<unsigned>(vec[0])); // Add the last digit
-    return a;
+    const basic_bigint(&yb)[4] = square ? x : y;
+    const basic_bigint(&wb)[5] = square ? va : vb;
+
+    // Pointwise products
+    basic_bigint c0 = mul_signed(x[0], yb[0]);
+    basic_bigint c6 = mul_signed(x[3], yb[3]);
+    basic_bigint r_p1 = mul_signed(va[0], wb[0]);
+    basic_bigint r_m1 = mul_signed(va[1], wb[1]);
+    basic_bigint r_p2 = mul_signed(va[2], wb[2]);
+    basic_bigint r_m2 = mul_signed(va[3], wb[3]);
+    basic_bigint r_p3 = mul_signed(va[4], wb[4]);
+
+    // Even part: c2 + c4 = u and c2 + 4 c4 = v / 4
+    basic_bigint u = r_p1 + r_m1;
+    div_exact(u, 2);
+    u -= c0;
+    u -= c6;
+    basic_bigint v = r_p2 + r_m2;
+    div_exact(v, 2);
+    v -= c0;
+    basic_bigint t = c6;
+    t.mul_add_limb(64, 0);
+    v -= t;
+    div_exact(v, 4);
+    basic_bigint c4 = v - u;
+    div_exact(c4, 3);
+    basic_bigint c2 = u - c4;
+
+    // Odd part: c1 + c3 + c5 = o1, c1 + 4 c3 + 16 c5 = o2 and c1 + 9 c3 + 81 c5 = o3
+    basic_bigint o1 = r_p1 - r_m1;
+    div_exact(o1, 2);
+    basic_bigint o2 = r_p2 - r_m2;
+    div_exact(o2, 4);
+    basic_bigint o3 = c6; // r(3) - c0 - 9 c2 - 81 c4 - 729 c6, then divided by 3
+    o3.mul_add_limb(729, 0);
+    t = c4;
+    t.mul_add_limb(81, 0);
+    o3 += t;
+    t = c2;
+    t.mul_add_limb(9, 0);
+    o3 += t;
+    o3 += c0;
+    o3 = r_p3 - o3;
+    div_exact(o3, 3);
+
+    basic_bigint p = o2 - o1; // 3 c3 + 15 c5
+    div_exact(p, 3);
+    basic_bigint q = o3 - o2; // 5 c3 + 65 c5
+    div_exact(q, 5);
+    basic_bigint c5 = q - p; // 8 c5
+    div_exact(c5, 8);
+    t = c5;
+    t.mul_add_limb(5, 0);
+    basic_bigint c3 = p - t;
+    basic_bigint c1 = o1 - c3;
+    c1 -= c5;
+
+    // Recomposition
+    std::fill(res, res + an + bn, 0);
+    add_shifted(res, an + bn, c0, 0);
+    add_shifted(res, an + bn, c1, m);
+    add_shifted(res, an + bn, c2, 2 * m);
+    add_shifted(res, an + bn, c3, 3 * m);
+    add_shifted(res, an + bn, c4, 4 * m);
+    add_shifted(res, an + bn, c5, 5 * m);
+    add_shifted(res, an + bn, c6, 6 * m);
 }
 
 /**
- * @brief Checks if the bigint is positive.
+ * @brief Checks that a product can be computed exactly by mul_fft.
  *
- * @return If the bigint is positive, then return true, otherwise return false.
+ * The transform length must not exceed the 2-adic order of the primes, and every convolution coefficient
+ * (at most bn pieces * (piece base - 1)^2) must be smaller than the product of the three primes.
+ * Bigger products are cut into smaller ones by Toom-4 first.
+ *
+ * @param an The number of limbs of the longer operand.
+ * @param bn The number of limbs of the shorter operand.
+ * @return True if mul_fft can multiply these sizes.
  */
-bool bigint::get_positive()
+template <uint64_t Radix, typename Alloc>
+bool basic_bigint<Radix, Alloc>::fft_fits(size_t an, size_t bn)
 {
-    return is_Positive;
+    const double_limb_type primes = static_cast<double_limb_type>(bigint_detail::ntt_prime_1::mod) * bigint_detail::ntt_prime_2::mod * bigint_detail::ntt_prime_3::mod;
+    const double_limb_type coefficient = static_cast<double_limb_type>(bn * s_fft_pieces) * (s_fft_piece_base - 1) * (s_fft_piece_base - 1);
+    return (an + bn) * s_fft_pieces <= bigint_detail::ntt_max_length && coefficient < primes;
 }
 
 /**
- * @brief Overloads the += operator for bigint addition.
+ * @brief Multiplication with a three-prime number-theoretic transform, in O(n log n).
  *
- * @param rhs is the bigint value to be added.
- * @return A reference to the current bigint.
+ * Every limb is cut into s_fft_pieces small pieces. The pieces of a and b are convolved modulo three primes,
+ * the exact coefficients are rebuilt with the Chinese remainder theorem (Garner's form), then the carries are
+ * propagated in the piece base and the pieces are packed back into limbs. No floating point is involved, so
+ * the result is exact.
+ *
+ * @param a The first factor.
+ * @param an The number of limbs of a.
+ * @param b The second factor.
+ * @param bn The number of limbs of b.
+ * @param res The result, an + bn limbs. It must not overlap a or b.
  */
-bigint &bigint::operator+=(const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::mul_fft(const limb_type *a, size_t an, const limb_type *b, size_t bn, limb_type *res)
 {
-    bigint copy_rhs(rhs); // Copy rhs to avoid self-addition issue.
+    using namespace bigint_detail;
 
-    if (is_Positive == copy_rhs.is_Positive) // If it's an addition with the same sign
+    // Cut the limbs into pieces, least significant first
+    auto to_pieces = [](const limb_type *p, size_t n)
     {
-        while (vec.size() <= copy_rhs.vec.size())
-        {
-            vec.push_back(0);
-        }
-        uint8_t temp = 0; // Carry for addition
-        size_t i = 0;
-        for (i = 0; i < copy_rhs.vec.size(); ++i)
+        std::vector<uint32_t> pieces(n * s_fft_pieces);
+        for (size_t i = 0; i < n; ++i)
         {
-            vec.at(i) = static_cast<unsigned char>(vec.at(i) + temp + copy_rhs.vec.at(i));
-            if (vec[i] >= 10)
-            {
-                temp = 1; // Go to the next position
-                vec[i] = static_cast<unsigned char>(vec[i] - 10);
-            }
-            else
+            limb_type limb = p[i];
+            for (size_t k = 0; k < s_fft_pieces; ++k)
             {
-                temp = 0;
+                pieces[i * s_fft_pieces + k] = static_cast<uint32_t>(limb % s_fft_piece_base);
+                limb /= s_fft_piece_base;
             }
         }
+        return pieces;
+    };
+    const bool square = (a == b && an == bn); // Then the pieces of a are convolved with themselves
+    std::vector<uint32_t> pa = to_pieces(a, an), pb;
+    if (!square)
+    {
+        pb = to_pieces(b, bn);
+    }
+    const std::vector<uint32_t> &qb = square ? pa : pb;
 
-        for (; i < vec.size(); ++i)
-        {
-            vec.at(i) = static_cast<unsigned char>(vec[i] + temp + 0);
-            if (vec[i] >= 10)
-            {
-                temp = 1; // Go to the next position
-                vec[i] -= 10;
-            }
-            else
-                temp = 0;
-        }
-        if (temp > 0)
-        {
-            vec.push_back(temp); // Handle final carry
-        }
+    size_t n = 1;
+    while (n < pa.size() + qb.size() - 1)
+    {
+        n <<= 1;
     }
-    else // else it's an addition with the different sign
+    std::vector<uint32_t> r1 = ntt_prime_1::convolve(pa, qb, n);
+    std::vector<uint32_t> r2 = ntt_prime_2::convolve(pa, qb, n);
+    std::vector<uint32_t> r3 = ntt_prime_3::convolve(pa, qb, n);
+
+    // Garner: x = x1 + p1 * t1 + p1 * p2 * t2, with each t chosen so that x matches the next residue
+    constexpr uint64_t p1 = ntt_prime_1::mod, p2 = ntt_prime_2::mod, p3 = ntt_prime_3::mod;
+    constexpr uint64_t p1_inv_mod_p2 = pow_mod(p1, p2 - 2, p2); // Inverses by Fermat's little theorem
+    constexpr uint64_t p12_inv_mod_p3 = pow_mod(p1 * p2 % p3, p3 - 2, p3);
+
+    std::fill(res, res + an + bn, 0);
+    double_limb_type carry = 0;
+    const size_t total = (an + bn) * s_fft_pieces;
+    limb_type limb = 0, scale = 1;
+    for (size_t i = 0; i < total; ++i)
     {
-        if (is_Positive == true && copy_rhs.is_Positive == false)
+        if (i < pa.size() + qb.size() - 1)
         {
-            bigint temp(copy_rhs);
-            temp.is_Positive = true; // Make the rhs positive
-            *this -= temp;
+            uint64_t t1 = (r2[i] + p2 - r1[i] % p2) % p2 * p1_inv_mod_p2 % p2;
+            uint64_t x12 = r1[i] + p1 * t1;
+            uint64_t t2 = (r3[i] + p3 - x12 % p3) % p3 * p12_inv_mod_p3 % p3;
+            carry += x12 + static_cast<double_limb_type>(p1 * p2) * t2;
         }
-        else
+        limb_type piece = static_cast<limb_type>(carry % s_fft_piece_base);
+        carry /= s_fft_piece_base;
+
+        // Pack the pieces back into limbs
+        limb += piece * scale;
+        scale *= s_fft_piece_base;
+        if ((i + 1) % s_fft_pieces == 0)
         {
-            bigint temp(*this);
-            temp.is_Positive = true; // Make the current bigint positive
-            *this = copy_rhs - temp;
+            res[i / s_fft_pieces] = limb;
+            limb = 0;
+            scale = 1;
         }
     }
-    trim(); // Remove leading zeros.
-    return *this;
 }
 
 /**
- * @brief Overloads the + operator for bigint addition.
+ * @brief Builds a positive bigint from a range of limbs.
  *
- * @param lhs The first bigint.
- * @param rhs The second bigint.
- * @return The result of adding lhs and rhs.
+ * @param p The first limb.
+ * @param n The number of limbs, may be 0 for the value zero.
+ * @return The trimmed bigint.
  */
-bigint operator+(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::from_limbs(const limb_type *p, size_t n)
 {
-    bigint ret(lhs);
-    ret += rhs; // Reuse the += operator.
+    basic_bigint ret;
+    if (n > 0)
+    {
+        ret.vec.assign(p, p + n);
+        ret.trim();
+    }
     return ret;
 }
 
 /**
- * @brief Overloads the -= operator for bigint subtraction.
+ * @brief Multiplies two bigints with mul_limbs, without going through operator*=.
  *
- * @param rhs The bigint value to be subtracted.
- * @return A reference to the current bigin.
+ * @param x The first factor.
+ * @param y The second factor.
+ * @return The signed product.
  */
-bigint &bigint::operator-=(const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+basic_bigint<Radix, Alloc> basic_bigint<Radix, Alloc>::mul_signed(const basic_bigint &x, const basic_bigint &y)
 {
+    basic_bigint ret(x.get_allocator());
+    ret.vec.assign(x.vec.size() + y.vec.size(), 0);
+    mul_limbs(x.vec.data(), x.vec.size(), y.vec.data(), y.vec.size(), ret.vec.data());
+    ret.is_Positive = (x.is_Positive == y.is_Positive);
+    ret.trim();
+    return ret;
+}
 
-    if (!rhs.is_Positive) // If rhs is negative, perform addition
-    {
-        bigint temp(rhs);
-        temp.is_Positive = true;
-        *this += temp;
-        return *this;
-    }
-    if (!is_Positive && rhs.is_Positive) // If rhs is positive and lhs is negative, perform addition
-    {
-        bigint temp(rhs);
-        temp.is_Positive = false; // Convert rhs to negative
-        *this += temp;            // Perform addition
-        return *this;
-    }
-    bigint a;
-    if (*this < rhs) // If current bigint is less than rhs, swap them
-    {
-        a = *this;
-        *this = rhs;
-        this->is_Positive = false;
-    }
-    else
-    {
-        a = rhs;
-    }
+/**
+ * @brief Divides a bigint by a single limb when the remainder is known to be zero.
+ *
+ * @param x The bigint to divide, keeps its sign.
+ * @param d The divisor.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::div_exact(basic_bigint &x, limb_type d)
+{
+    div_limb(x.vec, d);
+    x.trim();
+}
 
-    uint8_t temp = 0; // Borrow for subtraction
-    size_t i = 0;
-    // std::cout << *this << "-" << val2  << std::endl;
-    for (i = 0; i < a.vec.size(); ++i)
+/**
+ * @brief Adds a non-negative bigint into a limb array at an offset of shift limbs.
+ *
+ * @param res The limb array.
+ * @param rn The number of limbs of res. The sum must fit.
+ * @param c The non-negative value to add.
+ * @param shift The offset, in limbs.
+ */
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::add_shifted(limb_type *res, size_t rn, const basic_bigint &c, size_t shift)
+{
+    size_t cn = c.vec.size();
+    if (shift >= rn || (cn == 1 && c.vec[0] == 0))
     {
-        if (vec[i] < temp + a.vec[i]) // Handle borrow
-        {
-
-            vec[i] = static_cast<unsigned char>(10 + vec[i] - (temp + a.vec[i]));
-            temp = 1; // Set borrow for next position
-        }
-        else
-        {
-            vec[i] = static_cast<unsigned char>(vec[i] - temp - a.vec[i]);
-            temp = 0;
-        }
+        return;
     }
-    // Handle borrow for remaining digits
-    for (; i < vec.size(); ++i)
+    add_n(res + shift, res + shift, rn - shift, c.vec.data(), std::min(cn, rn - shift));
+}
+
+/**
+ * @brief Subtracts a limb array multiplied by a single limb: r = r - a * q.
+ *
+ * @param r The array to subtract from, n limbs are updated.
+ * @param a The array to multiply.
+ * @param n The number of limbs of a.
+ * @param q The multiplier.
+ * @return The limb that must still be subtracted from r[n] (the high limb of the product plus the borrow).
+ */
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::submul_1(limb_type *r, const limb_type *a, size_t n, limb_type q)
+{
+    limb_type carry = 0;
+    for (size_t i = 0; i < n; ++i)
     {
-        if (vec[i] < temp)
-        {
-            vec[i] = static_cast<unsigned char>(10 + vec[i] - temp);
-            temp = 1;
-        }
-        else
-        {
-            vec[i] = static_cast<unsigned char>(vec[i] - temp);
-            temp = 0;
-        }
+        limb_type high = 0;
+        limb_type low = mul_add_limbs(a[i], q, carry, high);
+        limb_type borrow = 0;
+        r[i] = sub_limbs(r[i], low, borrow);
+        carry = high + borrow; // Stays below the base: when high is base - 1, low is 0 and nothing is borrowed
     }
-    // if(i < vec.size() && temp > 0){
-    //     vec[i] = static_cast<unsigned char>( vec[i] - temp);
-    // }
-    trim();
-    //    std::cout << " = " << *this << std::endl;
-    return *this;
+    return carry;
 }
 
 /**
- * @brief Overloads the - operator for bigint subtraction.
+ * @brief Schoolbook long division (Knuth, TAOCP vol. 2, 4.3.1, Algorithm D), one quotient limb per step.
+ *
+ * The divisor must be normalized: its top limb is at least half the base, so the quotient limb estimated from the
+ * top two limbs of the remainder and the top limb of the divisor is refined with the second limb of the divisor
+ * and is then at most one too big. That rare case is detected by the borrow of the subtraction and fixed by
+ * adding the divisor back.
  *
- * @param lhs The first bigint.
- * @param rhs The subtrahend bigint.
- * @return The result of subtracting rhs from lhs.
+ * @param q The quotient, un - vn limbs.
+ * @param u The dividend, un limbs. Its top vn limbs u[un - vn..un) must be below v, so that each quotient limb fits
+ * in a limb: a zero top limb, as left by the normalization, is enough, and div_recursive passes a high part that is
+ * already reduced. u is replaced by the remainder in its low vn limbs.
+ * @param un The number of limbs of u, un > vn.
+ * @param v The normalized divisor.
+ * @param vn The number of limbs of v, at least 2.
  */
-bigint operator-(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::div_basecase(limb_type *q, limb_type *u, size_t un, const limb_type *v, size_t vn)
 {
+    const double_limb_type base = is_binary ? (static_cast<double_limb_type>(1) << limb_bits) : Radix;
+    const limb_type v1 = v[vn - 1], v2 = v[vn - 2];
+    for (size_t j = un - vn; j-- > 0;)
+    {
+        // Estimate the quotient limb from the top limbs of the current remainder u[j..j+vn]
+        double_limb_type top = static_cast<double_limb_type>(u[j + vn]) * base + u[j + vn - 1];
+        double_limb_type qhat = top / v1;
+        double_limb_type rhat = top % v1;
+        while (qhat >= base || qhat * v2 > rhat * base + u[j + vn - 2])
+        {
+            --qhat;
+            rhat += v1;
+            if (rhat >= base)
+            {
+                break;
+            }
+        }
 
-    bigint ret(lhs);
-    ret -= rhs; // Reuse the -= operator.
-    return ret;
+        // u[j..j+vn] -= qhat * v, adding v back if qhat was still one too big
+        limb_type borrow = 0;
+        u[j + vn] = sub_limbs(u[j + vn], submul_1(u + j, v, vn, static_cast<limb_type>(qhat)), borrow);
+        if (borrow)
+        {
+            --qhat;
+            limb_type carry = add_n(u + j, u + j, vn, v, vn);
+            u[j + vn] = add_limbs(u[j + vn], 0, carry); // The final carry cancels the borrow
+        }
+        q[j] = static_cast<limb_type>(qhat);
+    }
 }
 
 /**
- * @brief Overloads the *= operator for bigint multiplication.
+ * @brief Recursive division (Burnikel and Ziegler, in the form of Brent and Zimmermann's RecursiveDivRem), in place
+ * on limb arrays.
  *
- * @param rhs The bigint value to multiply.
- * @return A reference to the current bigint.
+ * With k = m / 2 and v = v1 * base^k + v0, the top half of the quotient is the quotient of u / base^2k by v1
+ * (a division of half the size), corrected by subtracting q1 * v0 from the remainder; then the bottom half is
+ * found in the same way. The quotient estimated from v1 is never too small and only a little too big, so each
+ * half needs a few additions of v at most. The two half divisions and the products by v0 use the fast
+ * multiplication, so the division costs a small multiple of a multiplication of the same size. The products
+ * go to the scratch stack, nothing is allocated.
+ *
+ * @param q The quotient, m limbs.
+ * @param u The dividend, n + m limbs. The remainder is left in its n low limbs, the limbs above are garbage.
+ * @param m The number of limbs of the quotient, at most n.
+ * @param v The divisor, normalized (its top limb is at least half the base), n limbs.
+ * @param n The number of limbs of v.
+ * @return The top limb of the quotient (0 or 1): the quotient is this limb * base^m + q.
  */
-bigint &bigint::operator*=(const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::div_recursive(limb_type *q, limb_type *u, size_t m, const limb_type *v, size_t n)
 {
-    bigint result;
-    if (this->is_Positive == rhs.is_Positive)
-        result.is_Positive = true;
-    else
-        result.is_Positive = false;
+    static const limb_type one = 1;
 
-    std::vector<uint64_t> res_vec;
-    res_vec.resize(this->vec.size() + rhs.vec.size());
-    result.vec.resize(this->vec.size() + rhs.vec.size());
-
-    for (size_t i = 0; i < vec.size(); ++i)
+    // If u >= v * base^m, subtract it once: the rest of the quotient fits in m limbs
+    limb_type qh = 1;
+    for (size_t i = n; i-- > 0;)
     {
-        for (size_t j = 0; j < rhs.vec.size(); ++j)
+        if (u[m + i] != v[i])
         {
-            res_vec[i + j] = static_cast<uint64_t>(res_vec[i + j] + vec[i] * rhs.vec[j]);
+            qh = u[m + i] > v[i];
+            break;
         }
     }
+    if (qh)
+    {
+        sub_n(u + m, u + m, n, v, n);
+    }
 
-    // Handle carry and store the result in result.vec
-    uint64_t temp = 0;
-    for (size_t i = 0; i < res_vec.size(); ++i)
+    if (m < BIGINT_DIV_DC_THRESHOLD)
     {
-        uint64_t current_val = res_vec[i] + temp;               // Add carry
-        result.vec[i] = static_cast<uint8_t>(current_val % 10); // Store the least significant digit
-        temp = current_val / 10;                                // Calculate the new carry
+        div_basecase(q, u, n + m, v, n);
+        return qh;
     }
 
-    // Check if there is an extra carry left
-    if (temp > 0)
+    const size_t k = m / 2;
+    bigint_detail::scratch_frame frame;
+    limb_type *product = frame.take(m);
+
+    // Top half: q1 = (u / base^2k) / v1, then u = r1 * base^2k + u mod base^2k - q1 * v0 * base^k, which lies in u[0..n+k)
+    limb_type q1h = div_recursive(q + k, u + 2 * k, m - k, v + k, n - k);
+    mul_limbs(q + k, m - k, v, k, product);
+    limb_type borrow = sub_n(u + k, u + k, n, product, m);
+    if (q1h)
     {
-        result.vec.push_back(static_cast<uint8_t>(temp % 10)); // Store the carry as a digit
+        borrow += sub_n(u + m, u + m, n + k - m, v, k);
+    }
+    while (borrow) // The remainder is negative: q1 was too big
+    {
+        q1h -= sub_n(q + k, q + k, m - k, &one, 1);
+        borrow -= add_n(u + k, u + k, n, v, n);
     }
 
-    result.trim();
-    *this = result;
-    return *this;
+    // Bottom half, in the same way now that u < v * base^k
+    limb_type q0h = div_recursive(q, u + k, k, v + k, n - k);
+    mul_limbs(q, k, v, k, product);
+    borrow = sub_n(u, u, n, product, 2 * k);
+    if (q0h)
+    {
+        borrow += sub_n(u + k, u + k, n - k, v, k);
+    }
+    while (borrow)
+    {
+        q0h -= sub_n(q, q, k, &one, 1);
+        borrow -= add_n(u, u, n, v, n);
+    }
+    return qh;
 }
 
 /**
- * @brief Overloads the * operator for bigint multiplication.
+ * @brief Divides the magnitudes of two bigints: |a| = q * |b| + r with 0 <= r < |b|.
  *
- * @param lhs The first bigint(multiplicand).
- * @param rhs The second bigint(multiplier).
- * @return The result of multiplying lhs by rhs.
- */
-bigint operator*(const bigint &lhs, const bigint &rhs)
-{
-    bigint ret(lhs);
-    ret *= rhs; // Reuse *= operator.
-    return ret;
-}
-
-/**
- * @brief Overloads the /= operator for bigint division.
+ * A single-limb divisor uses div_limb. Otherwise both operands are multiplied by the same factor so that the top
+ * limb of the divisor is at least half the base (a shift for binary limbs), the division runs with div_normalized,
+ * and the remainder is divided back by the factor. All the intermediate limbs live in the scratch stack.
  *
- * @param rhs The bigint divisor.
- * @return A reference to the current bigint.
+ * @param a The dividend, its sign is ignored.
+ * @param b The divisor, not zero, its sign is ignored.
+ * @param q The quotient, positive. It may be a or b.
+ * @param r The remainder, positive. It may be a or b, but not q.
  */
-bigint &bigint::operator/=(const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::div_magnitude(const basic_bigint &a, const basic_bigint &b, basic_bigint &q, basic_bigint &r)
 {
-    if (rhs == bigint::s_zero)
+    const size_t an = a.vec.size(), bn = b.vec.size();
+    if (an < bn)
     {
-        throw std::invalid_argument("Cannot divide by zero."); // std::invalid_argument if the division is 0.
+        r = a;
+        r.is_Positive = true;
+        q = basic_bigint::s_zero;
+        return;
     }
-    if (*this == rhs) // If both values are equal, result is 1 or -1
+    if (bn == 1)
     {
-        *this = bigint::s_one;
-        this->is_Positive = (is_Positive == rhs.is_Positive); // Ensure correct sign.
-        return *this;
+        const limb_type d = b.vec[0]; // r may be b
+        q.vec = a.vec;
+        r = basic_bigint::s_zero;
+        r.vec[0] = div_limb(q.vec, d);
+        q.is_Positive = true;
+        return;
     }
 
-    bigint ret(0); // Store the result
-    bool sign_indicator = true;
-    if (is_Positive == rhs.is_Positive)
+    limb_type factor;
+    if constexpr (is_binary)
     {
-        sign_indicator = true;
+        factor = static_cast<limb_type>(1) << std::countl_zero(b.vec.back());
     }
     else
     {
-        sign_indicator = false;
+        factor = Radix / (b.vec.back() + 1);
     }
-
-    bigint divider(rhs);
-    bigint positive_val(rhs);
-    positive_val.is_Positive = true;
-
-    this->is_Positive = true;
-    divider.is_Positive = true;
-
-    if (*this < divider) // If the dividend is smaller than the divisor, the result is 0
+    // The normalized operands go to the scratch stack, so that the division only allocates its results
+    bigint_detail::scratch_frame frame;
+    limb_type *u = frame.take(an + 1), *v = frame.take(bn);
+    limb_type carry = 0;
+    for (size_t i = 0; i < an; ++i)
     {
-        *this = bigint::s_zero;
-        return *this;
+        u[i] = mul_add_limbs(a.vec[i], factor, 0, carry);
     }
-
-    bigint cnt = 0; // Keeps track of the current power of 10
-    while (*this > bigint::s_zero)
+    u[an] = carry; // The top bn limbs of u are now below v, also when this limb is zero
+    carry = 0;
+    for (size_t i = 0; i < bn; ++i)
     {
-        // std::cout << *this  << " " << divider  << " " << ret << std::endl;
-        if (*this >= divider) // Subtract divider from current value.
-        {
-            *this -= divider;
-            ret += pow(bigint::s_ten, bigint(cnt)); // Update the result with the power of 10
-            divider *= bigint::s_ten;               // Increase the divider by a factor of 10.
-            cnt++;
-            // std:: cout << "ret:" << ret.is_Positive << std::endl;
-        }
-        else
-        {
-            divider = positive_val; // Reset divider
-            cnt = 0;
-            if (*this < divider)
-            {
-                break;
-            }
-        }
-        divider.is_Positive = true; // Make sure the divider is positive.
+        v[i] = mul_add_limbs(b.vec[i], factor, 0, carry);
     }
 
-    ret.trim();
-    // std:: cout << "ret:" << ret << std::endl;
-    ret.is_Positive = sign_indicator; // Align the correct sign to the result
-    *this = ret;
-    return *this;
+    q.vec.assign(an + 1 - bn, 0); // q may be a or b, which are not read anymore
+    div_normalized(q.vec.data(), u, an + 1, v, bn);
+    r.vec.assign(u, u + bn);
+    q.is_Positive = true;
+    q.trim();
+
+    r.is_Positive = true;
+    div_limb(r.vec, factor);
+    r.trim();
 }
 
 /**
- * @brief Overloads the / operator for bigint division.
+ * @brief Divides normalized limb arrays: q = u / v, and the remainder is left in the vn low limbs of u.
  *
+ * Knuth's long division, or from BIGINT_DIV_DC_THRESHOLD limbs, a long division in base base^vn: the remainder
+ * starts as the top vn limbs, then every block of at most vn limbs below it gets one recursive division.
  *
- * @param lhs The dividend bigint.
- * @param rhs The divisor bigint.
- * @return The quotient of dividing lhs by rhs.
+ * @param q The quotient, un - vn limbs.
+ * @param u The dividend, un limbs, whose top vn limbs are below v.
+ * @param un The number of limbs of u.
+ * @param v The divisor, normalized (its top limb is at least half the base), at least 2 limbs.
+ * @param vn The number of limbs of v.
  */
-bigint operator/(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::div_normalized(limb_type *q, limb_type *u, size_t un, const limb_type *v, size_t vn)
 {
-    bigint ret(lhs);
-    ret /= rhs; // reuse /= operator.
-    return ret;
+    const size_t qn = un - vn;
+    if (vn >= BIGINT_DIV_DC_THRESHOLD && qn >= BIGINT_DIV_DC_THRESHOLD)
+    {
+        // The remainder stays below v, so no block has a top quotient limb
+        for (size_t pos = qn; pos > 0;)
+        {
+            const size_t len = std::min(vn, pos);
+            pos -= len;
+            div_recursive(q + pos, u + pos, len, v, vn);
+        }
+    }
+    else
+    {
+        div_basecase(q, u, un, v, vn);
+    }
 }
 
 /**
- * @brief Overloads the %= operator for bigint modulus.
+ * @brief Multiplies the magnitude by a single limb and adds another limb.
  *
- * @param rhs The bigint divisor.
- * @return A reference to the current bigint object.
+ * @param mul The limb to multiply by.
+ * @param add The limb to add after the multiplication.
  */
-bigint &bigint::operator%=(const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::mul_add_limb(limb_type mul, limb_type add)
 {
-
-    if (rhs == bigint::s_zero)
+    double_limb_type temp = add; // The addend is the initial carry
+    for (size_t i = 0; i < vec.size(); ++i)
     {
-        throw std::invalid_argument("Cannot divide by zero."); // std::invalid_argument if division by zero
+        double_limb_type cur = static_cast<double_limb_type>(vec[i]) * mul + temp;
+        if constexpr (is_binary)
+        {
+            vec[i] = static_cast<limb_type>(cur);
+            temp = cur >> limb_bits;
+        }
+        else
+        {
+            vec[i] = static_cast<limb_type>(cur % Radix);
+            temp = cur / Radix;
+        }
     }
-
-    *this -= (*this / rhs) * rhs;                      // calculate the modulus.
-    if (!this->is_Positive && *this != bigint::s_zero) // make sure the correct sign of result
+    // mul may be bigger than a decimal limb, so the carry can take more than one limb
+    while (temp > 0)
     {
-        this->is_Positive = false;
+        if constexpr (is_binary)
+        {
+            vec.push_back(static_cast<limb_type>(temp));
+            temp >>= limb_bits;
+        }
+        else
+        {
+            vec.push_back(static_cast<limb_type>(temp % Radix));
+            temp /= Radix;
+        }
     }
-
-    return *this;
 }
 
 /**
- * @brief Overloads the % operator for bigint modulus.
+ * @brief Divides a magnitude by a single limb in place, from the most significant limb downwards.
  *
- * @param lhs The dividend bigint.
- * @param rhs The divisor bigint.
- * @return The remainder of dividing lhs by rhs.
+ * @param v The magnitude to divide, trimmed afterwards.
+ * @param div The non-zero limb divisor.
+ * @return The remainder of the division.
  */
-bigint operator%(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+typename basic_bigint<Radix, Alloc>::limb_type basic_bigint<Radix, Alloc>::div_limb(limb_vector &v, limb_type div)
 {
-    bigint ret(lhs);
-    ret %= rhs; // reuse %= operator
-    return ret;
-}
-
-/**
- * @brief Overloads the prefix ++ operator for bigint.
- * *
- * @return A reference to the incremented bigint.
- */
-bigint &bigint::operator++()
-{
-    *this += bigint::s_one;
-    return *this;
+    limb_type rem = 0;
+    for (size_t i = v.size(); i-- > 0;)
+    {
+        double_limb_type cur;
+        if constexpr (is_binary)
+        {
+            cur = (static_cast<double_limb_type>(rem) << limb_bits) | v[i];
+        }
+        else
+        {
+            cur = static_cast<double_limb_type>(rem) * Radix + v[i];
+        }
+        v[i] = static_cast<limb_type>(cur / div);
+        rem = static_cast<limb_type>(cur % div);
+    }
+    while (v.size() > 1 && v.back() == 0)
+    {
+        v.pop_back();
+    }
+    return rem;
 }
 
 /**
- * @brief Overloads the prefix -- operator for bigint.
+ * @brief Converts validated decimal digits into limbs.
  *
- * @return A reference to the decremented bigint.
+ * Decimal limbs are filled directly from the right end of the digits. Binary limbs are computed by parse_decimal.
+ *
+ * @param digits The most significant digit.
+ * @param len The number of digits, at least 1.
  */
-bigint &bigint::operator--()
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::assign_decimal(const char *digits, size_t len)
 {
-    *this -= bigint::s_one;
-    return *this;
+    vec.clear();
+    if constexpr (!is_binary)
+    {
+        vec.reserve(len / s_decimal_chunk_digits + 1);
+        for (size_t end = len; end > 0;)
+        {
+            size_t begin = (end > s_decimal_chunk_digits) ? end - s_decimal_chunk_digits : 0;
+            limb_type chunk = 0;
+            for (size_t j = begin; j < end; ++j)
+            {
+                chunk = chunk * 10 + static_cast<limb_type>(digits[j] - '0');
+            }
+            vec.push_back(chunk);
+            end = begin;
+        }
+    }
+    else
+    {
+        vec.resize((len + s_decimal_chunk_digits - 1) / s_decimal_chunk_digits);
+        parse_decimal(digits, len, vec.data());
+        if (vec.size() > BIGINT_PARSE_DC_THRESHOLD)
+        {
+            trim_decimal_powers();
+        }
+    }
 }
 
 /**
- * @brief Overloads the postfix ++ operator for bigint.
- * *
- * @return The value of the bigint before the increment.
+ * @brief Returns the per-thread table of the powers of decimal_power, which starts with 10^19.
  */
-const bigint bigint::operator++(int)
+template <uint64_t Radix, typename Alloc>
+std::deque<typename basic_bigint<Radix, Alloc>::power_of_ten> &basic_bigint<Radix, Alloc>::decimal_power_table()
 {
-    bigint temp = *this;
-    ++(*this);
-    return bigint(temp);
+    thread_local std::deque<power_of_ten> table{power_of_ten{{s_decimal_chunk}, 0, {}}}; // push_back keeps the references valid
+    return table;
 }
 
 /**
- * @brief Overloads the postfix -- operator for bigint.
- * *
- * @return The value of the bigint before the decrement.
+ * @brief Returns (10^19)^(2^i), the value of a 1 followed by the zeros of a piece of 19 * 2^i digits.
+ *
+ * 10^k is a multiple of 2^k, so about 30% of the low limbs of these powers are zero. They are dropped, and the
+ * power is kept as p * base^zeros: the multiplications and divisions by the power only work on the limbs of p.
+ * The powers are computed by squaring and kept in a per-thread table for the next conversions, with the inverses
+ * used by div_barrett once they are asked for. The biggest power has about a third of the limbs of the biggest
+ * number converted, and its inverse about as many; trim_decimal_powers drops the biggest ones after a conversion.
+ *
+ * @param i The exponent of the power, (10^19)^(2^i).
+ * @param inverse Whether the inverse of p is needed.
+ * @return The power, valid until the outermost conversion calls trim_decimal_powers.
  */
-const bigint bigint::operator--(int)
+template <uint64_t Radix, typename Alloc>
+const typename basic_bigint<Radix, Alloc>::power_of_ten &basic_bigint<Radix, Alloc>::decimal_power(size_t i, bool inverse)
 {
-    bigint temp = *this;
-    --(*this);
-    return bigint(temp);
+    std::deque<power_of_ten> &table = decimal_power_table();
+    while (table.size() <= i)
+    {
+        const power_of_ten &last = table.back();
+        const size_t ln = last.limbs.size();
+        std::vector<limb_type> sq(2 * ln);
+        mul_limbs(last.limbs.data(), ln, last.limbs.data(), ln, sq.data());
+        size_t low = 0;
+        while (sq[low] == 0)
+        {
+            ++low;
+        }
+        size_t high = sq.size();
+        while (sq[high - 1] == 0)
+        {
+            --high;
+        }
+        table.push_back(power_of_ten{std::vector<limb_type>(sq.begin() + low, sq.begin() + high), 2 * last.zeros + low, {}});
+    }
+    power_of_ten &power = table[i];
+    if (inverse && power.inverse.empty())
+    {
+        const size_t n = power.limbs.size();
+        basic_bigint num, q, r;
+        num.vec.assign(2 * n + 1, 0);
+        num.vec.back() = 1;
+        div_magnitude(num, from_limbs(power.limbs.data(), n), q, r);
+        power.inverse.assign(q.vec.begin(), q.vec.end());
+    }
+    return power;
 }
 
 /**
- * @brief Overloads the unary + operator for bigint.
- * *
- * @return A reference to the current bigint object.
+ * @brief Frees the biggest cached powers of ten, like the scratch stack frees its blocks: the table keeps the
+ * smallest powers whose limbs and inverses fit in BIGINT_SCRATCH_KEEP words, so that one huge conversion does not
+ * pin its powers for the lifetime of the thread. Called when the outermost conversion returns, once no reference
+ * from decimal_power is in use anymore.
  */
-bigint &bigint::operator+()
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::trim_decimal_powers()
 {
-    return *this;
+    std::deque<power_of_ten> &table = decimal_power_table();
+    size_t keep = 1; // 10^19 itself always stays
+    size_t words = table[0].limbs.size();
+    while (keep < table.size() && words + table[keep].limbs.size() + table[keep].inverse.size() <= BIGINT_SCRATCH_KEEP)
+    {
+        words += table[keep].limbs.size() + table[keep].inverse.size();
+        ++keep;
+    }
+    table.erase(table.begin() + static_cast<std::ptrdiff_t>(keep), table.end());
 }
 
 /**
- * @brief Overloads the unary - operator for bigint.
- * *
- * @return A bigint with the opposite sign.
+ * @brief Converts len validated decimal digits to binary limbs.
+ *
+ * Up to BIGINT_PARSE_DC_THRESHOLD limbs, the value is built 19 digits at a time: multiply by 10^19, add the next
+ * chunk, which is quadratic. Longer strings are split so that the low part has exactly 19 * 2^i digits, with i as
+ * big as possible. Both parts are converted recursively and the result is high * (10^19)^(2^i) + low, so the
+ * conversion costs a few multiplications of the size of the result, O(M(n) log n), and the low parts of every level
+ * use the same cached powers.
+ *
+ * @param digits The most significant digit.
+ * @param len The number of digits, at least 1.
+ * @param res Receives the value in exactly ceil(len / 19) limbs, least significant first, padded with zeros.
  */
-bigint bigint::operator-() const
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::parse_decimal(const char *digits, size_t len, limb_type *res)
 {
-    bigint ret(*this);
-    // Avoid bigint a('0') output '-0' error, tested by test.
-    if (ret.vec.size() == 1 && ret.vec[0] == 0)
+    const size_t rn = (len + s_decimal_chunk_digits - 1) / s_decimal_chunk_digits;
+    std::fill(res, res + rn, 0);
+    if (rn <= BIGINT_PARSE_DC_THRESHOLD)
+    {
+        // The first chunk takes the leftover digits so that every following chunk is exactly 19 digits long
+        size_t used = 0;
+        size_t chunk_len = len % s_decimal_chunk_digits;
+        if (chunk_len == 0)
+        {
+            chunk_len = s_decimal_chunk_digits;
+        }
+        for (size_t i = 0; i < len; i += chunk_len, chunk_len = s_decimal_chunk_digits)
+        {
+            limb_type carry = 0;
+            limb_type scale = 1;
+            for (size_t j = i; j < i + chunk_len; ++j)
+            {
+                carry = carry * 10 + static_cast<limb_type>(digits[j] - '0');
+                scale *= 10;
+            }
+            for (size_t j = 0; j < used; ++j)
+            {
+                res[j] = mul_add_limbs(res[j], scale, 0, carry);
+            }
+            if (carry != 0)
+            {
+                res[used++] = carry;
+            }
+        }
+        return;
+    }
+
+    // The low part has 19 * 2^i digits, with 19 * 2^i < len <= 19 * 2^(i + 1)
+    size_t i = 0;
+    while ((size_t(2) << i) < rn)
     {
-        ret.is_Positive = true;
+        ++i;
     }
-    else
+    const size_t low_len = s_decimal_chunk_digits << i;
+    const size_t high_len = len - low_len;
+    parse_decimal(digits + high_len, low_len, res);
+
+    bigint_detail::scratch_frame frame;
+    size_t hn = (high_len + s_decimal_chunk_digits - 1) / s_decimal_chunk_digits;
+    limb_type *high = frame.take(hn);
+    parse_decimal(digits, high_len, high);
+    while (hn > 0 && high[hn - 1] == 0)
     {
-        ret.is_Positive = !ret.is_Positive;
+        --hn;
     }
-    return ret;
+    if (hn == 0)
+    {
+        return; // Leading zeros
+    }
+
+    const power_of_ten &power = decimal_power(i, false);
+    const size_t pn = power.limbs.size(), zeros = power.zeros;
+    const limb_type *p = power.limbs.data();
+    limb_type *prod = frame.take(hn + pn);
+    mul_limbs(high, hn, p, pn, prod);
+    size_t prod_n = hn + pn;
+    while (prod[prod_n - 1] == 0)
+    {
+        --prod_n;
+    }
+    add_n(res + zeros, res + zeros, rn - zeros, prod, prod_n); // Cannot carry out: the sum has at most len digits
 }
 
 /**
- * @brief Overloads the > operator for bigint.
+ * @brief Converts binary limbs to exactly len decimal digits, padded with leading zeros.
+ *
+ * Up to BIGINT_PRINT_DC_THRESHOLD limbs, the value is divided by 10^19 repeatedly, which gives the digits 19 at a
+ * time from the right, in quadratic time. Longer values are divided by the power (10^19)^(2^i) that leaves about
+ * half of the digits (between a third and two thirds) to the remainder, and the quotient and the remainder are
+ * converted recursively into their parts of the digits. The power is p * base^zeros, so only the limbs above
+ * the zeros are divided by p. From BIGINT_DIV_DC_THRESHOLD limbs, p has a cached inverse and the division is a
+ * Barrett division (two multiplications), below it is Knuth's division. The conversion costs O(M(n) log n).
  *
- * @param lhs The first bigint object.
- * @param rhs The second bigint object.
- * @return If lhs is greater than rhs, return true, otherwise false.
+ * @param a The value, n limbs (n may be 0).
+ * @param n The number of limbs of a.
+ * @param digits Receives the len digits, most significant first.
+ * @param len The number of digits to write, a must be below 10^len.
  */
-bool operator>(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::print_decimal(const limb_type *a, size_t n, char *digits, size_t len)
 {
-    if (lhs.is_Positive != rhs.is_Positive)
+    while (n > 0 && a[n - 1] == 0)
     {
-        return lhs.is_Positive; // Positive numbers > negative numbers
+        --n;
+    }
+    bigint_detail::scratch_frame frame;
+    if (n <= BIGINT_PRINT_DC_THRESHOLD)
+    {
+        limb_type *t = frame.take(n);
+        std::copy(a, a + n, t);
+        char *end = digits + len;
+        while (n > 0)
+        {
+            // t /= 10^19, the remainder is the next chunk of digits
+            limb_type rem = 0;
+            for (size_t i = n; i-- > 0;)
+            {
+                const double_limb_type cur = (static_cast<double_limb_type>(rem) << limb_bits) | t[i];
+                t[i] = static_cast<limb_type>(cur / s_decimal_chunk);
+                rem = static_cast<limb_type>(cur % s_decimal_chunk);
+            }
+            n -= (t[n - 1] == 0);
+            const size_t count = std::min(s_decimal_chunk_digits, static_cast<size_t>(end - digits));
+            write_chunk(end, rem, count);
+            end -= count;
+        }
+        std::fill(digits, end, '0');
+        return;
     }
 
-    if (lhs.is_Positive)
+    // The low part has 19 * 2^i digits, with len / 3 < 19 * 2^i <= 2 * len / 3
+    size_t i = 0;
+    while (3 * (s_decimal_chunk_digits << (i + 1)) <= 2 * len)
     {
-        if (lhs.vec.size() > rhs.vec.size())
-            return true; // The larger number of digits means greater
-        else if (lhs.vec.size() < rhs.vec.size())
-            return false;
+        ++i;
     }
-    else
+    const size_t low_len = s_decimal_chunk_digits << i;
+    const size_t high_len = len - low_len;
+    const bool barrett = decimal_power(i, false).limbs.size() >= BIGINT_DIV_DC_THRESHOLD;
+    const power_of_ten &power = decimal_power(i, barrett);
+    const limb_type *p = power.limbs.data();
+    const size_t pn = power.limbs.size(), zeros = power.zeros;
+    if (n < zeros + pn) // Below the power: the high digits are zeros
     {
-        if (lhs.vec.size() > rhs.vec.size())
-            return false; // For negative numbers, more digits means smaller
-        else if (lhs.vec.size() < rhs.vec.size())
-            return true;
+        std::fill(digits, digits + high_len, '0');
+        print_decimal(a, n, digits + high_len, low_len);
+        return;
     }
 
-    for (size_t i = lhs.vec.size(); i > 0;) // i-- > 0 ensures all indices from size()-1 to 0 are traversed
+    // Only the limbs above the zeros are divided by p, the remainder is u * base^zeros + the zero limbs of a
+    const size_t un = n - zeros;
+    limb_type *u = frame.take(zeros + un + 1), *q = frame.take(un - pn + 1);
+    std::copy(a, a + n, u);
+    if (barrett)
     {
-        i--;
-        if (lhs.vec[i] > rhs.vec[i])
-            return lhs.is_Positive;
-        else if (lhs.vec[i] < rhs.vec[i])
-            return !lhs.is_Positive;
+        div_barrett(q, u + zeros, un, p, pn, power.inverse.data(), power.inverse.size());
     }
-
-    return false;
+    else
+    {
+        // Knuth's division on p and the limbs above the zeros, both shifted to make the top bit of p set
+        const int shift = std::countl_zero(p[pn - 1]);
+        limb_type *v = frame.take(pn);
+        for (size_t j = pn; j-- > 0;)
+        {
+            v[j] = (p[j] << shift) | (shift == 0 || j == 0 ? 0 : p[j - 1] >> (limb_bits - shift));
+        }
+        limb_type *w = u + zeros;
+        w[un] = shift == 0 ? 0 : w[un - 1] >> (limb_bits - shift);
+        for (size_t j = un; j-- > 0;)
+        {
+            w[j] = (w[j] << shift) | (shift == 0 || j == 0 ? 0 : w[j - 1] >> (limb_bits - shift));
+        }
+        div_normalized(q, w, un + 1, v, pn);
+        for (size_t j = 0; j < pn; ++j)
+        {
+            w[j] = (w[j] >> shift) | (shift == 0 || j + 1 == pn ? 0 : w[j + 1] << (limb_bits - shift));
+        }
+    }
+    print_decimal(q, un - pn + 1, digits, high_len);
+    print_decimal(u, zeros + pn, digits + high_len, low_len);
 }
 
 /**
- * @brief Overloads the == operator for bigint.
+ * @brief Divides limb arrays with a precomputed inverse of the divisor (Barrett): q = u / p, and the remainder is
+ * left in the pn low limbs of u.
+ *
+ * u is divided from the top in blocks of at most pn limbs, a long division in base base^pn. With the remainder r
+ * of the blocks above, x = r * base^len + block is below p * base^pn, and the quotient of the block is estimated
+ * as (x / base^(pn - 1)) * m / base^(pn + 1). The estimate is never too big and at most 2 too small, so one
+ * multiplication gives the quotient, one more gives the remainder, and at most two subtractions of p fix them.
+ * This costs two multiplications per block instead of a recursive division, when the inverse is reused.
  *
- * @param lhs The first bigint object.
- * @param rhs The second bigint object.
- * @return If lhs is equal to rhs, return true, otherwise false.
+ * @param q The quotient, un - pn + 1 limbs.
+ * @param u The dividend, un limbs, at least pn. The limbs above the remainder are zero afterwards.
+ * @param un The number of limbs of u.
+ * @param p The divisor, pn limbs, the top one not zero.
+ * @param pn The number of limbs of p.
+ * @param m The inverse of p: floor(base^(2 * pn) / p).
+ * @param mn The number of limbs of m.
  */
-bool operator==(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::div_barrett(limb_type *q, limb_type *u, size_t un, const limb_type *p, size_t pn, const limb_type *m, size_t mn)
 {
-    // Handle the test problem: if lhs and rhs are zero, keeping them in same sign.
-    if (lhs.vec.size() == 1 && lhs.vec[0] == 0 && rhs.vec.size() == 1 && rhs.vec[0] == 0)
-        return true;
+    static const limb_type one = 1;
+    bigint_detail::scratch_frame frame;
+    limb_type *est = frame.take(pn + 1 + mn), *prod = frame.take(2 * pn);
+
+    // Divides x (xn limbs, below base^(2 * pn)) by p into qn limbs of quotient, the remainder is left in x
+    auto divide_block = [&](limb_type *x, size_t xn, limb_type *quotient, size_t qn)
+    {
+        std::fill(quotient, quotient + qn, 0);
+        while (xn > 0 && x[xn - 1] == 0)
+        {
+            --xn;
+        }
+        if (xn < pn)
+        {
+            return; // Already below p
+        }
+        mul_limbs(x + pn - 1, xn - pn + 1, m, mn, est);
+        size_t en = std::min(xn + mn - 2 * pn, qn); // The estimate is est / base^(pn + 1), xn + mn - 2 * pn >= 1 limbs
+        const limb_type *e = est + pn + 1;
+        while (en > 0 && e[en - 1] == 0)
+        {
+            --en;
+        }
+        if (en > 0)
+        {
+            std::copy(e, e + en, quotient);
+            mul_limbs(e, en, p, pn, prod);
+            size_t prod_n = en + pn;
+            while (prod[prod_n - 1] == 0)
+            {
+                --prod_n;
+            }
+            sub_n(x, x, xn, prod, prod_n); // The estimate is never too big
+            while (xn > 0 && x[xn - 1] == 0)
+            {
+                --xn;
+            }
+        }
+        while (xn >= pn && cmp_n(x, xn, p, pn) >= 0) // At most twice
+        {
+            sub_n(x, x, xn, p, pn);
+            add_n(quotient, quotient, qn, &one, 1);
+            while (xn > 0 && x[xn - 1] == 0)
+            {
+                --xn;
+            }
+        }
+    };
 
-    if (lhs.is_Positive != rhs.is_Positive || lhs.vec.size() != rhs.vec.size())
-        return false; // different sign or size means they are not equal
-    for (size_t i = 0; i < lhs.vec.size(); i++)
+    // The top pn limbs give at most one quotient limb, then each block of len limbs below the remainder gives len
+    divide_block(u + un - pn, pn, q + un - pn, 1);
+    for (size_t pos = un - pn; pos > 0;)
     {
-        if (lhs.vec[i] != rhs.vec[i])
-            return false; // If any digit differs, then not equal.
+        const size_t len = std::min(pn, pos);
+        pos -= len;
+        divide_block(u + pos, len + pn, q + pos, len);
     }
-    return true;
 }
 
 /**
- * @brief Overloads the >= operator for bigint.
+ * @brief Writes the count low digits of chunk in the given base, padded with zeros, in the count characters before end.
  *
- * @param lhs The first bigint object.
- * @param rhs The second bigint object.
- * @return If lhs is greater than or equal to rhs, return true, otherwise false.
+ * @param end One past the last character to write.
+ * @param chunk The value, below base^count.
+ * @param count The number of digits to write.
+ * @param base The base, from 2 to 36.
  */
-bool operator>=(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::write_chunk(char *end, limb_type chunk, size_t count, unsigned base)
 {
-    return (lhs > rhs) || (lhs == rhs); // convert to the > and == case.
+    for (size_t j = 0; j < count; ++j)
+    {
+        *--end = bigint_detail::digit_chars[chunk % base];
+        chunk /= base;
+    }
 }
 
 /**
- * @brief Overloads the < operator for bigint.
+ * @brief Returns how many digits of the base fit in one chunk for the conversions: the biggest power of the base
+ * below 2^64. mul_add_limb and the division by a limb take such multipliers and divisors for every radix.
  *
- * @param lhs The first bigint object.
- * @param rhs The second bigint object.
- * @return If lhs is less than rhs, return true, otherwise false.
+ * @param base The base, from 2 to 36.
+ * @param chunk Receives base^digits.
+ * @return The number of digits.
  */
-bool operator<(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+unsigned basic_bigint<Radix, Alloc>::chunk_digits(unsigned base, limb_type &chunk)
 {
-    return !(lhs >= rhs); // convert to the !>= case.
+    unsigned digits = 1;
+    chunk = base;
+    while (chunk <= UINT64_MAX / base)
+    {
+        chunk *= base;
+        ++digits;
+    }
+    return digits;
 }
 
 /**
- * @brief Overloads the <= operator for bigint.
+ * @brief Assigns the value of a string of digits in the given base, after checking every character.
  *
- * @param lhs The first bigint object.
- * @param rhs The second bigint object.
- * @return If lhs is less than or equal to rhs, return true, otherwise false.
+ * @param str An optional '-', then at least one digit of the base.
+ * @param base The base, from 2 to 36.
  */
-bool operator<=(const bigint &lhs, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::assign_string(const std::string &str, int base)
 {
-    return !(lhs > rhs); // convert to the !> case.
-}
-
-/**
- * @brief Overloads the != operator for bigint.
- * *
- * @param lhs The first bigint object.
- * @param rhs The second bigint object.
- * @return If lhs is not equal to rhs, return true, otherwise false.
- */
-bool operator!=(const bigint &lhs, const bigint &rhs)
-{
-    return !(lhs == rhs); // convert to the !== case.
+    bigint_detail::check_base(base); // std::invalid_argument: If the base is not between 2 and 36.
+    if (str.empty())
+    {
+        throw std::invalid_argument("Input string is empty"); // std::invalid_argument: If the string is empty.
+    }
+    const size_t temp = (str[0] == '-') ? 1 : 0; // The indicator for skipping the '-'.
+    if (str.length() == temp)
+    {
+        throw std::invalid_argument("Input string is only '-' or empty"); // std::invalid_argument: If the string is '-'.
+    }
+    for (size_t i = temp; i < str.length(); ++i)
+    {
+        if (bigint_detail::digit_value(str[i]) >= static_cast<unsigned>(base))
+        {
+            throw std::invalid_argument("Input string contains a character that is not a digit of the base"); // std::invalid_argument: If a character is not a digit of the base.
+        }
+    }
+    assign_radix(str.data() + temp, str.length() - temp, static_cast<unsigned>(base));
+    is_Positive = (temp == 0);
+    trim();
 }
 
 /**
- * @brief Overloads the << operator for bigint output.
+ * @brief Converts validated digits of the given base into limbs.
+ *
+ * Base 10 uses assign_decimal. With binary limbs and a power-of-two base, every digit gives log2(base) bits, which
+ * are put in place from the right end: this is linear. Otherwise the digits are read in chunks that fit in a limb,
+ * from the most significant one, with one mul_add_limb per chunk (quadratic).
  *
- * @param out The output stream.
- * @param rhs A constant reference to the bigint object to be output.
- * @return A reference to the output stream.
+ * @param digits The most significant digit.
+ * @param len The number of digits, at least 1.
+ * @param base The base, from 2 to 36.
  */
-std::ostream &operator<<(std::ostream &out, const bigint &rhs)
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::assign_radix(const char *digits, size_t len, unsigned base)
 {
-    if (rhs.vec.empty() || (rhs.vec.size() == 1 && rhs.vec[0] == 0)) // Handle the bigint is 0
+    if (base == 10)
     {
-        out << "0";
-        return out;
+        assign_decimal(digits, len);
+        return;
     }
-
-    if (!rhs.is_Positive)
+    if constexpr (is_binary)
     {
-        out << '-';
+        if (std::has_single_bit(base))
+        {
+            const unsigned bits = static_cast<unsigned>(std::countr_zero(base));
+            vec.assign((len * bits + limb_bits - 1) / limb_bits, 0);
+            size_t pos = 0;
+            for (size_t i = len; i-- > 0; pos += bits)
+            {
+                const limb_type v = bigint_detail::digit_value(digits[i]);
+                const size_t shift = pos % limb_bits;
+                vec[pos / limb_bits] |= v << shift;
+                if (shift + bits > limb_bits) // The digit straddles two limbs (bases 8 and 32)
+                {
+                    vec[pos / limb_bits + 1] |= v >> (limb_bits - shift);
+                }
+            }
+            return;
+        }
     }
 
-    for (size_t i = rhs.vec.size(); i-- > 0;)
+    limb_type chunk_base;
+    const size_t per_chunk = chunk_digits(base, chunk_base);
+    vec.assign(1, limb_type(0));
+    // The first chunk takes the leftover digits so that every following chunk is exactly per_chunk digits long
+    size_t chunk_len = len % per_chunk;
+    if (chunk_len == 0)
     {
-        out << static_cast<unsigned>(rhs.vec[i]); // Output each digit
+        chunk_len = per_chunk;
+    }
+    for (size_t i = 0; i < len; i += chunk_len, chunk_len = per_chunk)
+    {
+        limb_type chunk = 0;
+        limb_type scale = 1;
+        for (size_t j = i; j < i + chunk_len; ++j)
+        {
+            chunk = chunk * base + bigint_detail::digit_value(digits[j]);
+            scale *= base;
+        }
+        mul_add_limb(scale, chunk);
     }
-
-    return out;
 }
 
 /**
- * @brief Calculate the power of a bigint raised to a bigint exponent.
+ * @brief Writes the sign and the digits of the bigint in the given base, without leading zeros.
  *
- * @param base The base bigint.
- * @param exponent The exponent bigint.
- * @return The result of base raised to the power of exponent.
+ * Base 10 uses write_decimal. With binary limbs and a power-of-two base, the digits are read from the bits of the
+ * limbs (linear). Otherwise a copy of the limbs in the scratch space is divided by the biggest power of the base
+ * that fits in a limb, which gives the digits a chunk at a time from the right (quadratic).
+ *
+ * @param out The buffer, of at least digits_upper_bound(base) characters.
+ * @param base The base, from 2 to 36.
+ * @return The number of characters written.
  */
-bigint pow(const bigint &base, const bigint &exponent)
+template <uint64_t Radix, typename Alloc>
+size_t basic_bigint<Radix, Alloc>::write_radix(char *out, unsigned base) const
 {
-    if (!exponent.is_Positive) // Exponent must be non negative
+    if (base == 10)
     {
-        throw std::invalid_argument("Negative exponent is not supported for bigint."); // std::invalid_argument If the exponent is negative.
+        return write_decimal(out);
     }
-
-    if (exponent == bigint::s_zero) // Any number raised to the power of 0 is 1.
+    const size_t size = digits_upper_bound(static_cast<int>(base));
+    size_t sign = 0;
+    if (!is_Positive)
     {
-        return bigint::s_one;
+        out[0] = '-';
+        sign = 1;
     }
-
-    if (base == bigint::s_zero) // 0 raised to any power is 0
+    char *digits = out + sign;
+    const size_t len = size - sign;
+    if constexpr (is_binary)
     {
-        return bigint::s_zero;
+        if (std::has_single_bit(base))
+        {
+            const unsigned bits = static_cast<unsigned>(std::countr_zero(base));
+            const limb_type mask = base - 1;
+            for (size_t j = 0, pos = 0; j < len; ++j, pos += bits)
+            {
+                const size_t shift = pos % limb_bits, index = pos / limb_bits;
+                limb_type v = vec[index] >> shift;
+                if (shift + bits > limb_bits && index + 1 < vec.size())
+                {
+                    v |= vec[index + 1] << (limb_bits - shift);
+                }
+                digits[len - 1 - j] = bigint_detail::digit_chars[v & mask];
+            }
+            return size; // The bound is exact
+        }
     }
 
-    bigint ret(bigint::s_one); // Result starts at 1
-    bigint base2(base);        // Copy of the base
-    bigint exp(exponent);      // Copy of the exponent
-
-    while (exp > bigint::s_zero)
+    limb_type chunk_base;
+    const size_t per_chunk = chunk_digits(base, chunk_base);
+    bigint_detail::scratch_frame frame;
+    size_t n = vec.size();
+    limb_type *t = frame.take(n);
+    std::copy(vec.begin(), vec.end(), t);
+    char *end = digits + len;
+    while (n > 1 || t[0] != 0)
     {
-        if (exp % bigint::s_two == bigint::s_one) // If the current exponent is odd
+        // t /= chunk_base, the remainder is the next chunk of digits
+        limb_type rem = 0;
+        for (size_t i = n; i-- > 0;)
+        {
+            double_limb_type cur;
+            if constexpr (is_binary)
+            {
+                cur = (static_cast<double_limb_type>(rem) << limb_bits) | t[i];
+            }
+            else
+            {
+                cur = static_cast<double_limb_type>(rem) * Radix + t[i];
+            }
+            t[i] = static_cast<limb_type>(cur / chunk_base);
+            rem = static_cast<limb_type>(cur % chunk_base);
+        }
+        while (n > 1 && t[n - 1] == 0) // A chunk can be bigger than a decimal limb
         {
-            ret *= base2;
+            --n;
         }
-        base2 *= base2;       // Square the base
-        exp /= bigint::s_two; // Divide the exponent by 2
+        const size_t count = std::min(per_chunk, static_cast<size_t>(end - digits));
+        write_chunk(end, rem, count, base);
+        end -= count;
     }
-    return ret;
+    std::fill(digits, end, '0');
+
+    size_t zeros = 0;
+    while (zeros + 1 < len && digits[zeros] == '0')
+    {
+        ++zeros;
+    }
+    if (zeros > 0)
+    {
+        std::copy(digits + zeros, digits + len, digits);
+    }
+    return size - zeros;
 }
 
 /**
  * @brief Trims the leading zeros from the bigint vector.
  */
-void bigint::trim()
+template <uint64_t Radix, typename Alloc>
+void basic_bigint<Radix, Alloc>::trim()
 {
     while (vec.size() > 1 && vec[vec.size() - 1] == 0) // Remove zeros.
     {
@@ -1050,4 +5110,375 @@ void bigint::trim()
     }
 }
 
+/**
+ * @brief Opt-in expression templates for compound formulas such as a * b + c * d - e.
+ *
+ * The operators of bigint are eager: every operation returns a new bigint. Wrapping one operand in lazy() makes
+ * +, - and * build an expression tree instead. It computes nothing until it is assigned to a bigint, or added to or
+ * subtracted from one:
+ *
+ *     using bigint_expr::lazy;
+ *     x = lazy(a) * b + lazy(c) * d - e; // One pass into x
+ *     x += lazy(a) * b;                  // Fused multiply-add
+ *
+ * The evaluation fuses the chain of additions and subtractions: the first term is written into the limbs of the
+ * destination and the other ones are added to them in place. Products are computed in the scratch space of the thread,
+ * so the two lines above do not build any temporary bigint. Other operators (/, %, comparisons...) evaluate the
+ * expression into a bigint first. A sum or a difference used as a factor, as in lazy(a) * (b + c), is evaluated into
+ * a temporary. The destination may appear in the expression: when it is read after the first term has been written,
+ * the expression is evaluated into a temporary that then replaces the destination.
+ *
+ * An expression refers to its bigint lvalue operands, so it must be evaluated before they change or go out of scope,
+ * normally in the statement that builds it. Temporaries and native integers are stored in the expression.
+ */
+namespace bigint_expr
+{
+    /**
+     * @brief Gives the expressions access to the in-place kernels of basic_bigint.
+     */
+    struct access
+    {
+        template <typename B>
+        static void add_value(B &dest, const B &x, bool negate)
+        {
+            dest.add_value(x, negate);
+        }
+        template <typename B>
+        static void add_product(B &dest, const B &x, const B &y, bool negate)
+        {
+            dest.add_product(x, y, negate);
+        }
+        template <typename B>
+        static void assign_product(B &dest, const B &x, const B &y)
+        {
+            dest.assign_product(x, y);
+        }
+        template <typename B>
+        static void assign_native(B &dest, bool positive, uint64_t m)
+        {
+            dest.assign_native(positive, m);
+        }
+        template <typename B>
+        static void add_native(B &dest, bool positive, uint64_t m)
+        {
+            dest.add_native(positive, m);
+        }
+    };
+
+    /**
+     * @brief Common part of the expression nodes. Every node provides:
+     * - evaluate_into(dest): dest = value of the expression,
+     * - add_into(dest, negate): dest += value (or -= value when negate is true),
+     * - refers_to(x): whether evaluating the expression reads x.
+     */
+    template <typename B>
+    struct node
+    {
+        using value_type = B;
+        static constexpr bool is_bigint_expression = true;
+    };
+
+    /**
+     * @brief Whether T is an expression node.
+     */
+    template <typename T>
+    concept expression = std::remove_cvref_t<T>::is_bigint_expression;
+
+    /**
+     * @brief Evaluates a node into a new bigint, for the operands of a product.
+     */
+    template <typename E>
+    typename E::value_type materialize(const E &e, const typename E::value_type::allocator_type &alloc)
+    {
+        typename E::value_type ret(alloc);
+        e.evaluate_into(ret);
+        return ret;
+    }
+
+    /**
+     * @brief A leaf referring to a bigint.
+     */
+    template <typename B>
+    class term : public node<B>
+    {
+    public:
+        explicit term(const B &v) : value(v) {}
+
+        void evaluate_into(B &dest) const
+        {
+            if (&dest != &value)
+            {
+                dest = value; // Reuses the limb buffer of dest
+            }
+        }
+        void add_into(B &dest, bool negate) const { access::add_value(dest, value, negate); }
+        bool refers_to(const B &x) const { return &x == &value; }
+        const B &materialize(const typename B::allocator_type &) const { return value; }
+
+    private:
+        const B &value;
+    };
+
+    /**
+     * @brief A leaf holding a temporary bigint operand.
+     */
+    template <typename B>
+    class constant : public node<B>
+    {
+    public:
+        explicit constant(B &&v) : value(std::move(v)) {}
+
+        void evaluate_into(B &dest) const { dest = value; }
+        void add_into(B &dest, bool negate) const { access::add_value(dest, value, negate); }
+        bool refers_to(const B &) const { return false; }
+        const B &materialize(const typename B::allocator_type &) const { return value; }
+
+    private:
+        B value;
+    };
+
+    /**
+     * @brief A leaf holding a native integer. It is only turned into limbs when the expression is evaluated, so they
+     * come from the allocator of the destination (or of the temporary of a product).
+     */
+    template <typename B>
+    class native : public node<B>
+    {
+    public:
+        native(bool positive, uint64_t m) : positive(positive), magnitude(m) {}
+
+        void evaluate_into(B &dest) const { access::assign_native(dest, positive, magnitude); }
+        void add_into(B &dest, bool negate) const { access::add_native(dest, positive != negate, magnitude); }
+        bool refers_to(const B &) const { return false; }
+
+    private:
+        bool positive;
+        uint64_t magnitude;
+    };
+
+    /**
+     * @brief The sum (or the difference when Subtract is true) of two nodes.
+     */
+    template <typename L, typename R, bool Subtract>
+    class sum : public node<typename L::value_type>
+    {
+        using B = typename L::value_type;
+
+    public:
+        sum(L l, R r) : left(std::move(l)), right(std::move(r)) {}
+
+        void evaluate_into(B &dest) const
+        {
+            if (right.refers_to(dest)) // right would read dest after left has overwritten it
+            {
+                B ret(dest.get_allocator());
+                left.evaluate_into(ret);
+                right.add_into(ret, Subtract);
+                dest = std::move(ret);
+                return;
+            }
+            left.evaluate_into(dest);
+            right.add_into(dest, Subtract);
+        }
+        void add_into(B &dest, bool negate) const
+        {
+            if (right.refers_to(dest))
+            {
+                access::add_value(dest, materialize(*this, dest.get_allocator()), negate);
+                return;
+            }
+            left.add_into(dest, negate);
+            right.add_into(dest, negate != Subtract);
+        }
+        bool refers_to(const B &x) const { return left.refers_to(x) || right.refers_to(x); }
+
+    private:
+        L left;
+        R right;
+    };
+
+    /**
+     * @brief The product of two nodes, computed in the scratch space and written or added into the destination.
+     */
+    template <typename L, typename R>
+    class product : public node<typename L::value_type>
+    {
+        using B = typename L::value_type;
+
+    public:
+        product(L l, R r) : left(std::move(l)), right(std::move(r)) {}
+
+        void evaluate_into(B &dest) const
+        {
+            const auto &x = materialize_operand(left, dest);
+            const auto &y = materialize_operand(right, dest);
+            access::assign_product(dest, x, y);
+        }
+        void add_into(B &dest, bool negate) const
+        {
+            const auto &x = materialize_operand(left, dest);
+            const auto &y = materialize_operand(right, dest);
+            access::add_product(dest, x, y, negate);
+        }
+        bool refers_to(const B &x) const { return left.refers_to(x) || right.refers_to(x); }
+
+    private:
+        L left;
+        R right;
+
+        // Leaves are used in place, other nodes are evaluated into a temporary (whose lifetime is extended by the caller)
+        template <typename E>
+        static decltype(auto) materialize_operand(const E &e, const B &dest)
+        {
+            if constexpr (requires { e.materialize(dest.get_allocator()); })
+            {
+                return e.materialize(dest.get_allocator());
+            }
+            else
+            {
+                return materialize(e, dest.get_allocator());
+            }
+        }
+    };
+
+    /**
+     * @brief The negation of a node.
+     */
+    template <typename E>
+    class negation : public node<typename E::value_type>
+    {
+        using B = typename E::value_type;
+
+    public:
+        explicit negation(E e) : inner(std::move(e)) {}
+
+        void evaluate_into(B &dest) const
+        {
+            inner.evaluate_into(dest);
+            dest = -std::move(dest); // Flips the sign in the same limbs
+        }
+        void add_into(B &dest, bool negate) const { inner.add_into(dest, !negate); }
+        bool refers_to(const B &x) const { return inner.refers_to(x); }
+
+    private:
+        E inner;
+    };
+
+    /**
+     * @brief Turns an operand into a node: nodes are kept, bigint lvalues are referred to, and bigint temporaries and
+     * native integers are stored.
+     */
+    template <typename B, expression E>
+    std::remove_cvref_t<E> to_node(E &&e)
+    {
+        return std::forward<E>(e);
+    }
+    template <typename B>
+    term<B> to_node(const B &x)
+    {
+        return term<B>(x);
+    }
+    template <typename B>
+    constant<B> to_node(B &&x)
+    {
+        return constant<B>(std::move(x));
+    }
+    template <typename B, bigint_detail::native_integer T>
+    native<B> to_node(T x)
+    {
+        return native<B>(!bigint_detail::is_negative(x), bigint_detail::magnitude(x));
+    }
+
+    /**
+     * @brief Whether T can be combined with an expression whose value is a B.
+     */
+    template <typename T, typename B>
+    concept operand_of = expression_of<T, B> || std::same_as<std::remove_cvref_t<T>, B> || bigint_detail::native_integer<std::remove_cvref_t<T>>;
+
+    /**
+     * @brief The value type of the expression among the two operands of a binary operator.
+     */
+    template <typename L, typename R>
+    using value_of = typename std::remove_cvref_t<std::conditional_t<expression<L>, L, R>>::value_type;
+
+    /**
+     * @brief Operands of the lazy operators: at least one of them is an expression, the other one is an expression,
+     * a bigint or a native integer of the same bigint type.
+     */
+    template <typename L, typename R>
+    concept lazy_operands = (expression<L> || expression<R>) && operand_of<L, value_of<L, R>> && operand_of<R, value_of<L, R>>;
+
+    /**
+     * @brief Starts an expression: the operators applied to lazy(x) are evaluated lazily.
+     *
+     * @param x The bigint operand. It is referred to, not copied.
+     * @return A leaf referring to x.
+     */
+    template <uint64_t Radix, typename Alloc>
+    term<basic_bigint<Radix, Alloc>> lazy(const basic_bigint<Radix, Alloc> &x)
+    {
+        return term<basic_bigint<Radix, Alloc>>(x);
+    }
+
+    /**
+     * @brief The lazy operators. They only build the expression tree.
+     */
+    template <typename L, typename R>
+        requires lazy_operands<L, R>
+    auto operator+(L &&lhs, R &&rhs)
+    {
+        using B = value_of<L, R>;
+        auto l = to_node<B>(std::forward<L>(lhs));
+        auto r = to_node<B>(std::forward<R>(rhs));
+        return sum<decltype(l), decltype(r), false>(std::move(l), std::move(r));
+    }
+
+    template <typename L, typename R>
+        requires lazy_operands<L, R>
+    auto operator-(L &&lhs, R &&rhs)
+    {
+        using B = value_of<L, R>;
+        auto l = to_node<B>(std::forward<L>(lhs));
+        auto r = to_node<B>(std::forward<R>(rhs));
+        return sum<decltype(l), decltype(r), true>(std::move(l), std::move(r));
+    }
+
+    template <typename L, typename R>
+        requires lazy_operands<L, R>
+    auto operator*(L &&lhs, R &&rhs)
+    {
+        using B = value_of<L, R>;
+        auto l = to_node<B>(std::forward<L>(lhs));
+        auto r = to_node<B>(std::forward<R>(rhs));
+        return product<decltype(l), decltype(r)>(std::move(l), std::move(r));
+    }
+
+    template <expression E>
+    auto operator-(E &&e)
+    {
+        using B = typename std::remove_cvref_t<E>::value_type;
+        return negation<std::remove_cvref_t<E>>(to_node<B>(std::forward<E>(e)));
+    }
+}
+
+#if defined(__cpp_lib_format)
+/**
+ * @brief Formats bigints with std::format, in decimal. The format specification is the one of strings (fill,
+ * alignment and width, e.g. "{:>30}"). The digits are written in the scratch space of the thread, not in a
+ * temporary string.
+ */
+template <uint64_t Radix, typename Alloc>
+struct std::formatter<basic_bigint<Radix, Alloc>, char> : std::formatter<std::string_view, char>
+{
+    template <typename FormatContext>
+    auto format(const basic_bigint<Radix, Alloc> &x, FormatContext &ctx) const
+    {
+        bigint_detail::scratch_frame frame;
+        char *digits = reinterpret_cast<char *>(frame.take(x.digits10_upper_bound() / sizeof(uint64_t) + 1));
+        const size_t n = x.write_decimal(digits);
+        return std::formatter<std::string_view, char>::format(std::string_view(digits, n), ctx);
+    }
+};
+#endif
+
 #endif
\ No newline at end of file
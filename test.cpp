@@ -13,6 +13,7 @@
 #include "bigint.hpp" // The bigint class is defined in this header file.
 #include <random>     // Provide random number generation
 #include <fstream>    // Provide file stream for input and output operations
+#include <iomanip>    // Provide std::setw for the padded output
 
 /**
  * @brief Counters for tracking test results. This section maintains counters for different kinds of tests
@@ -346,6 +347,158 @@ void Assignment_Operator()
     check("Different Length Assignment", e, "-11111111");
 }
 
+/**
+ * @brief Test the move constructor, move assignment and swap for bigint.
+ */
+void Move_And_Swap()
+{
+    std::cout << "Move and Swap Test\n";
+    static_assert(std::is_nothrow_move_constructible_v<bigint> && std::is_nothrow_move_assignable_v<bigint>, "bigint moves must not throw");
+
+    bigint a("-123456789012345678901234567890");
+    bigint b(std::move(a));
+    check("Move Constructor", b, "-123456789012345678901234567890");
+    check("Moved-From Is Zero", a, "0"); // A moved-from bigint is a valid zero
+    a += bigint("5");
+    check("Use After Move", a, "5");
+    a = bigint("42"); // A moved-from bigint can be assigned again
+    check("Assign After Move", a, "42");
+
+    bigint c("7");
+    c = std::move(b);
+    check("Move Assignment", c, "-123456789012345678901234567890");
+    check("Moved-From By Assignment", b == bigint(0) && b.get_value() == "0", true);
+    b -= bigint("3");
+    check("Use After Move Assignment", b, "-3");
+    c = std::move(c);
+    check("Self Move Assignment", c, "-123456789012345678901234567890");
+
+    bigint d("1");
+    bigint e("-98765432109876543210");
+    swap(d, e);
+    check("Swap First", d, "-98765432109876543210");
+    check("Swap Second", e, "1");
+    std::swap(d, e);
+    check("std::swap", d, "1");
+
+    // Copies into a bigint that already has enough limbs
+    bigint f(std::string(100, '9'));
+    f = bigint("5");
+    f = e;
+    check("Copy Into Bigger", f, "-98765432109876543210");
+}
+
+/**
+ * @brief Tests values around the number of limbs stored inline, which move to the heap when they grow.
+ */
+void Inline_Limbs()
+{
+    std::cout << "\n Test Inline Limbs\n";
+
+    bigint a("115792089237316195423570985008687907853269984665640564039457584007913129639935"); // 2^256 - 1, four limbs
+    bigint b = a + 1; // Five limbs
+    check("Grow Past Inline", b, "115792089237316195423570985008687907853269984665640564039457584007913129639936");
+    check("Limbs After Growing", b.get_vec_size() == 5, true);
+    b -= 1;
+    check("Shrink Back", b, a);
+    check("Square Past Inline", sqr(a + 1) / (a + 1), "115792089237316195423570985008687907853269984665640564039457584007913129639936");
+
+    // Moves and swaps between inline and heap limbs
+    bigint small("-42");
+    bigint big(sqr(a));
+    swap(small, big);
+    check("Swap Inline With Heap", big, "-42");
+    check("Swap Heap With Inline", small, sqr(a));
+    bigint moved(std::move(big));
+    check("Move Inline Limbs", moved, "-42");
+    big = std::move(small);
+    check("Move Heap Limbs", big, sqr(a));
+    small = moved;
+    check("Copy Inline Into Moved", small, "-42");
+
+    // Arithmetic on values of a few limbs stays inline
+    bigint x("170141183460469231731687303715884105727"); // 2^127 - 1
+    bigint y = x * 3 / 7;
+    check("Small Product and Quotient", y, "72917650054486813599294558735378902454");
+    decimal_bigint d(std::string(72, '9'));
+    check("Decimal Grow Past Inline", (d + 1).get_value(), "1" + std::string(72, '0'));
+}
+
+/**
+ * @brief Copies a pmr_bigint. It is a function of its own, with the whole copy inlined into it, so that the copy
+ * is compiled (and checked by -Wall) for a source of unknown size, as in a small user translation unit.
+ *
+ * @param x The bigint to copy.
+ * @return The copy.
+ */
+[[gnu::flatten]] pmr_bigint Pmr_Copy(const pmr_bigint &x)
+{
+    pmr_bigint copy(x);
+    return copy;
+}
+
+/**
+ * @brief Tests bigints whose limbs come from a std::pmr memory resource.
+ */
+void Pmr_Allocator()
+{
+    std::cout << "\n Test Allocator-Aware Limbs\n";
+
+    // The arena and the default resource cannot fall back on the heap: every limb must come from the buffer
+    static char buffer[1 << 16];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    std::pmr::memory_resource *old = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    pmr_bigint a(std::string(100, '7'), &arena);
+    pmr_bigint b(std::string(50, '3'), &arena);
+    pmr_bigint c = a * b + a - b;
+    pmr_bigint q = c / b, r = c % b;
+    check("Arena Arithmetic", c.get_value(),
+          "259259259259259259259259259259259259259259259259264444444444444444444444444444444444444444444444444385185185185185185185185185185185185185185185185185");
+    check("Arena Division", q * b + r == c, true);
+    check("Result Allocator", c.get_allocator().resource() == &arena, true);
+
+    // The temporaries of every division form, and of native integers in lazy expressions, use the operand's allocator
+    pmr_bigint x(std::string(400, '8'), &arena), y(std::string(200, '6'), &arena);
+    pmr_bigint z(x, &arena);
+    z /= y;
+    pmr_bigint m(x, &arena);
+    m %= y;
+    auto [dq, dr] = divmod(x, y);
+    check("Arena Division Assignment", z == dq && m == dr && dq * y + dr == x, true);
+    check("Arena Rvalue Division", (x + 1) / y == dq && (x + 1) % y == dr + 1, true);
+    pmr_bigint e(&arena);
+    e = bigint_expr::lazy(z) * 3 + 1000000007;
+    check("Arena Lazy Native Operand", e == dq * 3 + 1000000007, true);
+    std::pmr::set_default_resource(old);
+
+    // Between unequal allocators, swap copies the limbs and each bigint keeps its allocator
+    pmr_bigint heap(std::string(100, '9'));
+    swap(heap, a);
+    check("Swap Across Resources", a.get_value(), std::string(100, '9'));
+    check("Swap Keeps Allocator", a.get_allocator().resource() == &arena, true);
+    check("Swap Across Resources Back", heap.get_value(), std::string(100, '7'));
+
+    // A copy does not keep the arena of its source, like std::pmr::vector; the allocator-extended copy does
+    pmr_bigint copy = Pmr_Copy(a);
+    check("Copy Uses Default Resource", copy == a && copy.get_allocator().resource() == std::pmr::get_default_resource(), true);
+    pmr_bigint arena_copy(a, &arena);
+    check("Copy Into Resource", arena_copy == a && arena_copy.get_allocator().resource() == &arena, true);
+    check("Operator Keeps Left Allocator", (a + 1).get_allocator().resource() == &arena, true);
+
+    // A temporary on the right of a left operand with another allocator is not reused for the result
+    pmr_bigint left(std::string(60, '5'));
+    const pmr_bigint sum = left + a * a, difference = left - a * a, product = left * (a + a);
+    check("Left Allocator With Right Temporary", sum.get_allocator().resource() == std::pmr::get_default_resource() &&
+                                                     difference.get_allocator().resource() == std::pmr::get_default_resource() &&
+                                                     product.get_allocator().resource() == std::pmr::get_default_resource(), true);
+    check("Right Temporary Values", sum - left == a * a && left - difference == a * a && product == left * a * 2, true);
+
+    // pmr containers pass their resource to the bigints they hold
+    std::pmr::vector<pmr_bigint> v(&arena);
+    v.push_back(heap);
+    check("Uses-Allocator Construction", v[0] == heap && v[0].get_allocator().resource() == &arena, true);
+}
+
 /**
  * @brief Test the assignment operator for int64_t in the bigint class.
  */
@@ -398,6 +551,39 @@ void String_Assignment_Operator()
     check("String with Leading Zeros", a, "123");
 }
 
+/**
+ * @brief Tests strings long enough to be converted by divide and conquer, around the sizes where they are split.
+ *
+ * A piece of 19 * 2^i digits fits in 2^i limbs, so the lengths around 760 and 1520 digits change the splitting.
+ */
+void Long_String_Conversion()
+{
+    std::cout << "\n Test Long String Conversion\n";
+
+    for (size_t digits : {759, 760, 761, 1520, 1521, 30000})
+    {
+        std::string pattern;
+        while (pattern.size() < digits)
+        {
+            pattern += "1234567890987654321";
+        }
+        pattern.resize(digits);
+        const std::string length = std::to_string(digits) + " Digits";
+        check("Round Trip of " + length, bigint(pattern).get_value() == pattern, true);
+        check("Power of Ten of " + length, bigint("1" + std::string(digits, '0')) == pow(bigint(10), bigint(int64_t(digits))), true);
+        check("All Nines of " + length, bigint(std::string(digits, '9')) + bigint(1) == pow(bigint(10), bigint(int64_t(digits))), true);
+    }
+
+    // Leading zeros make the high part of a split zero
+    check("Long Leading Zeros", bigint(std::string(3000, '0') + "123"), "123");
+    check("Only Zeros", bigint("-" + std::string(5000, '0')), "0");
+
+    // The assignment operator uses the same conversion
+    bigint a;
+    a = "-" + std::string(2000, '9');
+    check("Long String Assignment", a == -pow(bigint(10), bigint(2000)) + bigint(1), true);
+}
+
 /**
  * @brief Tests the get_value() method of the bigint class.
  */
@@ -481,6 +667,14 @@ void Plus_Equal_Operator()
     bigint e("111111111111111111111111111");
     e += e;
     check("Self Addition", e, "222222222222222222222222222");
+
+    // Carry and borrow rippling through the unrolled word loop and its tail: 2^576 - 1 has nine full limbs
+    const std::string full = "247330401473104534060502521019647190035131349101211839914063056092897225106531867170316401061243044989597671426016139339351365034306751209967546155101893167916606772148699135";
+    bigint f(full);
+    f += bigint(1);
+    check("Carry Through Nine Limbs", f, "247330401473104534060502521019647190035131349101211839914063056092897225106531867170316401061243044989597671426016139339351365034306751209967546155101893167916606772148699136");
+    f += bigint("-" + full);
+    check("Borrow Through Nine Limbs", f, "1");
 }
 
 /**
@@ -523,6 +717,14 @@ void Subtraction_Equal_Operator()
     check("Zero - Zero", (bigint("0") -= bigint("0")), "0");
     check("Zero - Positive", (bigint("0") -= bigint("111")), "-111");
     check("Zero - Negative", (bigint("0") -= bigint("-111")), "111");
+
+    // Same object on both sides, borrows through whole limbs and a shorter result of opposite sign
+    bigint b("340282366920938463463374607431768211456"); // 2^128
+    b -= b;
+    check("Object Minus Itself", b, "0");
+    check("Borrow Across Limbs", (bigint("340282366920938463463374607431768211456") -= bigint("1")), "340282366920938463463374607431768211455");
+    check("Longer Subtrahend", (bigint("5") -= bigint("340282366920938463463374607431768211456")), "-340282366920938463463374607431768211451");
+    check("Same Top Limbs", (bigint("340282366920938463463374607431768211456") -= bigint("340282366920938463463374607431768211457")), "-1");
 }
 
 /**
@@ -546,6 +748,31 @@ void Subtraction_Operator()
     check("Zero - Zero", (bigint("0") - bigint("0")), "0");
 }
 
+/**
+ * @brief Tests additions, subtractions and comparisons long enough for the vectorized kernels, where carries and
+ * borrows cross whole blocks of limbs.
+ */
+void Vectorized_Kernels()
+{
+    std::cout << "\n Test Vectorized Limb Kernels\n";
+
+    bigint p = pow(bigint(2), bigint(64 * 40)); // 41 limbs: 1 followed by 40 zero limbs
+    bigint m = p - bigint(1);                   // 40 limbs of all ones
+    check("Carry Across Blocks", m + bigint(1) == p, true);
+    check("Borrow Across Blocks", p - m, "1");
+    check("Longer Carry", m + m == p + p - bigint(2), true);
+    check("Difference Below Zero", m - p, "-1");
+    bigint q = m;
+    q -= bigint(1) + p / bigint("18446744073709551616"); // Clears the top limb and borrows through the ones
+    check("Borrow Into Top Limb", q == m - p / bigint("18446744073709551616") - bigint(1), true);
+
+    // Comparisons that differ in a low limb only, or in the top one
+    bigint a = m - bigint(5), b = m - bigint(6);
+    check("Compare Low Limb", a > b && b < a && a != b, true);
+    check("Compare Top Limb", m > m - p / bigint(4), true);
+    check("Compare Equal", (m <=> bigint(m)) == 0, true);
+}
+
 /**
  * @brief Tests the *= operator for bigint multiplication.
  */
@@ -591,6 +818,96 @@ void Multiplication_Operator()
     check("Self Multiplication", (bigint("100") * bigint("100")), "10000");
 }
 
+/**
+ * @brief Tests multiplication of operands long enough to use the Karatsuba algorithm.
+ *
+ * Uses (10^a - 1) * (10^b - 1) = 10^(a + b) - 10^a - 10^b + 1, whose digits are known for any a >= b.
+ */
+void Karatsuba_Multiplication()
+{
+    std::cout << "\n Test Karatsuba Multiplication\n";
+
+    // Balanced operands, both far above the threshold
+    bigint a(std::string(3000, '9'));
+    check("Balanced Karatsuba", a * a, std::string(2999, '9') + "8" + std::string(2999, '0') + "1");
+    decimal_bigint d(std::string(3000, '9'));
+    check("Balanced Karatsuba (decimal)", (d * d).get_value(), std::string(2999, '9') + "8" + std::string(2999, '0') + "1");
+
+    // Unbalanced operands, the longer one is cut into pieces
+    bigint b(std::string(700, '9'));
+    check("Unbalanced Karatsuba", a * b, std::string(699, '9') + "8" + std::string(2300, '9') + std::string(699, '0') + "1");
+
+    // Signs
+    check("Negative Karatsuba", (-a) * b, "-" + std::string(699, '9') + "8" + std::string(2300, '9') + std::string(699, '0') + "1");
+}
+
+/**
+ * @brief Tests multiplication of operands long enough to use the Toom-3 and Toom-4 algorithms.
+ *
+ * The results have tens of thousands of digits, so only the comparison with the expectation is printed.
+ */
+void Toom_Cook_Multiplication()
+{
+    std::cout << "\n Test Toom-Cook Multiplication\n";
+
+    // About 600 limbs: Toom-3
+    bigint a(std::string(12000, '9'));
+    check("Toom-3 Square", a * a == bigint(std::string(11999, '9') + "8" + std::string(11999, '0') + "1"), true);
+    bigint b(std::string(9000, '9'));
+    check("Toom-3 Different Lengths", -a * b == bigint("-" + std::string(8999, '9') + "8" + std::string(3000, '9') + std::string(8999, '0') + "1"), true);
+
+    // About 3600 limbs: Toom-4
+    bigint c(std::string(70000, '9'));
+    check("Toom-4 Square", c * c == bigint(std::string(69999, '9') + "8" + std::string(69999, '0') + "1"), true);
+    bigint d("1" + std::string(69999, '0'));
+    check("Toom-4 Power of Ten", c * d == bigint(std::string(70000, '9') + std::string(69999, '0')), true);
+}
+
+/**
+ * @brief Tests multiplication of operands long enough to use the number-theoretic transform.
+ */
+void FFT_Multiplication()
+{
+    std::cout << "\n Test FFT (NTT) Multiplication\n";
+
+    // About 6800 limbs each
+    bigint a(std::string(130000, '9'));
+    check("FFT Square", a * a == bigint(std::string(129999, '9') + "8" + std::string(129999, '0') + "1"), true);
+    bigint b(std::string(120000, '9'));
+    check("FFT Different Lengths", a * b == bigint(std::string(119999, '9') + "8" + std::string(10000, '9') + std::string(119999, '0') + "1"), true);
+    decimal_bigint d(std::string(130000, '9'));
+    check("FFT Square (decimal)", d * d == decimal_bigint(std::string(129999, '9') + "8" + std::string(129999, '0') + "1"), true);
+
+    // Every limb is 2^64 - 1, the biggest possible convolution coefficients: (2^N - 1)^2 + 2^(N + 1) - 1 = 2^2N
+    bigint all_ones = pow(bigint(2), bigint(64 * 7000)) - bigint(1);
+    check("FFT Biggest Limbs", all_ones * all_ones + pow(bigint(2), bigint(64 * 7000 + 1)) - bigint(1) == pow(bigint(2), bigint(128 * 7000)), true);
+}
+
+/**
+ * @brief Tests the sqr function and the squaring path of operator*= (x *= x), at every algorithm size.
+ */
+void Squaring()
+{
+    std::cout << "\n Test Squaring (sqr)\n";
+
+    check("Square Zero", sqr(bigint("0")), "0");
+    check("Square Negative", sqr(bigint("-123456789012345678901234567890")), "15241578753238836750495351562536198787501905199875019052100");
+    bigint x("-18446744073709551616");
+    x *= x;
+    check("Self Multiplication", x, "340282366920938463463374607431768211456");
+
+    // Schoolbook, Karatsuba, Toom-3 and FFT squaring
+    for (size_t digits : {500, 3000, 20000, 130000})
+    {
+        bigint a(std::string(digits, '9'));
+        bigint b(a);
+        check("Square of " + std::to_string(digits) + " Digits", sqr(a) == a * b && sqr(a) == bigint(std::string(digits - 1, '9') + "8" + std::string(digits - 1, '0') + "1"), true);
+    }
+    decimal_bigint d(std::string(3000, '9'));
+    d *= d;
+    check("Self Multiplication (decimal)", d == decimal_bigint(std::string(2999, '9') + "8" + std::string(2999, '0') + "1"), true);
+}
+
 /**
  * @brief Tests the operator/= for bigint division.
  */
@@ -630,6 +947,77 @@ void Division_Operator()
     check("Negative / Negative", (bigint("-100") / bigint("-2")), "50");
 }
 
+/**
+ * @brief Tests the long division (Knuth's Algorithm D) on multi-limb divisors.
+ */
+void Long_Division()
+{
+    std::cout << "\n Test Long Division\n";
+
+    // The estimated quotient limb is one too big here, so the divisor is added back
+    bigint a("-3138550867693340382088035895064302439782865025947901362176");
+    bigint b("340282366920938463481821351505477763073");
+    check("Add Back Quotient", a / b, "-9223372036854775807");
+    check("Add Back Remainder", a % b, "-340282366920938463472597979468622987265");
+    check("Same Length, Smaller Dividend", bigint("3138550867693340382088035895064302439773641653911046586369") / bigint("3138550867693340382088035895064302439782865025947901362175"), "0");
+
+    // (10^2n - 1) / (10^n - 1) = 10^n + 1
+    bigint c(std::string(20000, '9'));
+    bigint d(std::string(10000, '9'));
+    check("Large Long Division", c / d == bigint("1" + std::string(9999, '0') + "1"), true);
+    check("Large Long Division Remainder", (c + bigint(12345)) % d, "12345");
+    decimal_bigint e(std::string(20000, '9'));
+    decimal_bigint f(std::string(10000, '9'));
+    check("Large Long Division (decimal)", e / f == decimal_bigint("1" + std::string(9999, '0') + "1"), true);
+}
+
+/**
+ * @brief Tests the recursive (divide-and-conquer) division, used when the divisor and the quotient are long.
+ */
+void Recursive_Division()
+{
+    std::cout << "\n Test Recursive Division\n";
+
+    // (10^2n - 1) / (10^n - 1) = 10^n + 1
+    bigint a(std::string(60000, '9'));
+    bigint b(std::string(30000, '9'));
+    check("Recursive Division", a / b == bigint("1" + std::string(29999, '0') + "1"), true);
+    check("Recursive Division Remainder", (a - bigint(1)) % b == bigint(std::string(29999, '9') + "8"), true);
+
+    // a = q * b + r with 0 <= r < b, with a dividend three times as long as the divisor
+    bigint c = pow(bigint(3), bigint(150000));
+    bigint d = -pow(bigint(7), bigint(30000));
+    bigint q = c / d, r = c % d;
+    check("Recursive Division Identity", q * d + r == c && r >= bigint(0) && r < -d, true);
+
+    decimal_bigint e = pow(decimal_bigint(3), decimal_bigint(150000));
+    decimal_bigint f = pow(decimal_bigint(7), decimal_bigint(30000));
+    decimal_bigint g = e / f, h = e % f;
+    check("Recursive Division Identity (decimal)", g * f + h == e && h < f, true);
+}
+
+/**
+ * @brief Tests that consecutive operations of different sizes reuse the scratch space of the kernels correctly.
+ */
+void Scratch_Reuse()
+{
+    std::cout << "\n Test Scratch Space Reuse\n";
+
+    bigint a = pow(bigint(3), bigint(20000)); // About 500 limbs: Toom-3 multiplication, recursive division
+    bigint b = pow(bigint(7), bigint(6000));
+    bigint c("123456789123456789123456789");
+    bool same = true;
+    for (int i = 0; i < 3; ++i)
+    {
+        same = same && (a * b) / b == a && (a * a) % b == (a % b) * (a % b) % b && c * c / c == c;
+    }
+    check("Repeated Operations", same, true);
+
+    // A quotient shorter than the divisor, and a divisor longer than the recursive division threshold
+    bigint d = a * b + b - bigint(1);
+    check("Short Quotient", d / a == b && d % a == b - bigint(1), true);
+}
+
 /**
  * @brief Tests the operator%= for bigint modulus.
  */
@@ -660,7 +1048,230 @@ void Modulus_Operator()
     bigint b("3");
     bigint c = a % b;
     check("Large Number % Small Number", c, "1");
-    // Because % reuse %=, the rest of the tests are no different from %=.
+    // Because % and %= share divmod, the rest of the tests are no different from %=.
+}
+
+/**
+ * @brief Tests the divmod function, which returns the quotient and the remainder of one division.
+ */
+void Divmod_Function()
+{
+    std::cout << "\n Test Divmod Function (divmod)\n";
+
+    auto [q, r] = divmod(bigint("-100"), bigint("3"));
+    check("Divmod Quotient", q, "-33");
+    check("Divmod Remainder", r, "-1");
+    auto [q2, r2] = divmod(bigint("123456789012345678901234567890"), bigint("-9876543210987654321"));
+    check("Divmod Large Quotient", q2, "-12499999886");
+    check("Divmod Large Remainder", r2, "925925941327160484");
+    auto [q3, r3] = divmod(bigint("7"), bigint("100000000000000000000000"));
+    check("Divmod Small Dividend", q3, "0");
+    check("Divmod Small Dividend Remainder", r3, "7");
+
+    // In-place variant, the results overwrite the operands
+    bigint a("100000000000000000000000000000000000000007");
+    bigint b("-100000000000000000000");
+    divmod(a, b, a, b);
+    check("In-place Divmod Quotient", a, "-1000000000000000000000");
+    check("In-place Divmod Remainder", b, "7");
+    bigint c("-987654321987654321");
+    bigint d("1000");
+    divmod(c, d, d, c);
+    check("Swapped In-place Divmod Quotient", d, "-987654321987654");
+    check("Swapped In-place Divmod Remainder", c, "-321");
+}
+
+/**
+ * @brief Tests the operators taking native integers (int64_t, uint64_t, int, ...) directly.
+ */
+void Native_Integer_Operators()
+{
+    std::cout << "\n Test Operators with Native Integers\n";
+
+    bigint a("18446744073709551615"); // 2^64 - 1, one full limb
+    check("Bigint + int", a + 1, "18446744073709551616");
+    check("int + Bigint", 1 + a, "18446744073709551616");
+    check("Bigint - uint64_t", a - UINT64_MAX, "0");
+    check("int64_t - Bigint", INT64_MIN - a, "-27670116110564327423");
+    check("Bigint * int64_t", a * INT64_MIN, "-170141183460469231722463931679029329920");
+    check("unsigned * Bigint", 10u * bigint("-5"), "-50");
+    check("Bigint / int", bigint("-100000000000000000000000") / 7, "-14285714285714285714285");
+    check("Bigint % int", bigint("-100000000000000000000000") % 7, "-5");
+    check("Bigint % uint64_t", a % UINT64_MAX, "0");
+    check("Zero * Negative", bigint(0) * -5, "0");
+
+    // Compound assignments
+    bigint b("-1");
+    b += 3;
+    check("Bigint += int", b, "2");
+    b -= UINT64_MAX;
+    check("Bigint -= uint64_t", b, "-18446744073709551613");
+    b *= -2;
+    check("Bigint *= int", b, "36893488147419103226");
+    b /= 1000;
+    check("Bigint /= int", b, "36893488147419103");
+    b %= 1000;
+    check("Bigint %= int", b, "103");
+
+    // Comparisons in both orders
+    check("Bigint == int", bigint("-5") == -5, true);
+    check("int != Bigint", 5 != bigint("-5"), true);
+    check("Bigint < uint64_t", bigint("18446744073709551614") < UINT64_MAX, true);
+    check("int64_t > Bigint", INT64_MIN > bigint("-9223372036854775809"), true);
+    check("Bigint >= int", a >= 0, true);
+    check("int <= Bigint", 0 <= bigint(0), true);
+
+    // Decimal limbs, with integers longer than a limb
+    decimal_bigint d("999999999999999999");
+    check("Decimal + uint64_t", (d + UINT64_MAX).get_value(), "19446744073709551614");
+    check("Decimal - int64_t", (d - INT64_MAX).get_value(), "-8223372036854775808");
+    check("Decimal / uint64_t", (decimal_bigint("36893488147419103230") / UINT64_MAX).get_value(), "2");
+    check("Decimal == uint64_t", decimal_bigint("18446744073709551615") == UINT64_MAX, true);
+}
+
+/**
+ * @brief Tests the operators on temporaries, which reuse the limbs of their rvalue operand.
+ */
+void Rvalue_Operators()
+{
+    std::cout << "\n Test Operators on Temporaries\n";
+
+    bigint a("123456789012345678901234567890");
+    bigint b("-98765432109876543210");
+    bigint c("18446744073709551616");
+    bigint d("-1");
+    check("Chained Addition", a + b + c + d, "123456788932026990865067576295");
+    check("Temporary on the Right", a + (b + c), "123456788932026990865067576296");
+    check("Temporary Minus Temporary", (a + b) - (b + a), "0");
+    check("Bigint Minus Temporary", b - (a + c), "-123456789129557855084820662716");
+    check("Literal Minus Bigint", bigint("1000000000000000000000000000000") - a, "876543210987654321098765432110");
+    check("Negated Temporary", -(a + b), "-123456788913580246791358024680");
+    check("Negated Zero Temporary", -(a - a), "0");
+    check("Chained Multiplication", a * b * c,
+          "-224926004081866954740436157880429288885359001574203650695013754470400");
+    check("Temporary Quotient", (a * c) / b, "-23058429882016995308259222225");
+    check("Temporary Remainder", (a * c) % b, "44123807325206367990");
+
+    // Self-addition without an intermediate copy
+    bigint x("340282366920938463463374607431768211455"); // 2^128 - 1, grows by a limb
+    x += x;
+    check("Self Addition", x, "680564733841876926926749214863536422910");
+
+    // A moved operand is consumed, the other keeps its value
+    bigint y("-5");
+    bigint z = std::move(y) + a;
+    check("Moved Operand Sum", z, "123456789012345678901234567885");
+    check("Other Operand Unchanged", a, "123456789012345678901234567890");
+}
+
+/**
+ * @brief Tests the lazy expressions of bigint_expr, evaluated in one pass into their destination.
+ */
+void Expression_Templates()
+{
+    std::cout << "\n Test Lazy Expressions\n";
+
+    using bigint_expr::lazy;
+    bigint a("123456789012345678901234567890");
+    bigint b("-98765432109876543210");
+    bigint c("18446744073709551616");
+    bigint d("-1");
+    bigint e("10000000000000000000000000000000000000000");
+    bigint x;
+    x = lazy(a) * b + lazy(c) * d - e;
+    check("Sum of Products", x, "-12193263123702179522496570642255910545184973078516");
+    bigint y = lazy(a) * (lazy(b) + c) - 3;
+    check("Nested Sum and Native Integer", y, "-9915887322629481382248179804214902093099852316663");
+    check("Negated Expression", bigint(-(lazy(a) - a - 5)), "5");
+    check("Eager Fallback", bigint(lazy(a) / b), a / b);
+
+    // Fused multiply-add into the destination
+    bigint z = e;
+    z += lazy(a) * b;
+    check("Multiply-Add", z, e + a * b);
+    z -= lazy(a) * b;
+    check("Multiply-Subtract", z, e);
+
+    // The destination may appear anywhere in the expression
+    x = a;
+    x = lazy(x) + x * x;
+    check("Destination Read Late", x, "15241578753238836750495351562659655576514250878776253619990");
+    x = a;
+    x = lazy(b) - x * c;
+    check("Destination in a Product", x, b - a * c);
+    x = a;
+    x -= lazy(x);
+    check("Destination Minus Itself", x, "0");
+
+    // Same results as the eager operators across the sizes of the multiplication algorithms
+    bool same = true;
+    for (size_t digits : {5, 50, 600, 6000})
+    {
+        bigint p(std::string(digits, '7')), q("-" + std::string(digits, '3')), r(std::string(digits / 2 + 1, '9'));
+        bigint s;
+        s = lazy(p) * q - lazy(r) * r + p;
+        same = same && s == p * q - r * r + p;
+        s += lazy(p) * p;
+        same = same && s == p * q - r * r + p + p * p;
+    }
+    check("Same as Eager Operators", same, true);
+}
+
+/**
+ * @brief Tests addmul and submul, which accumulate a product into an existing bigint.
+ */
+void Fused_Multiply_Accumulate()
+{
+    std::cout << "\n Test Fused Multiply-Accumulate (addmul, submul)\n";
+
+    bigint a("123456789012345678901234567890");
+    bigint b("-98765432109876543210");
+    bigint c("18446744073709551616");
+    bigint acc = c;
+    addmul(acc, a, b);
+    check("Addmul Changing Sign", acc, "-12193263113702179522496570642219017057037553975284");
+    acc = c;
+    submul(acc, a, b);
+    check("Submul", acc, "12193263113702179522496570642255910545184973078516");
+    acc = a * b;
+    submul(acc, a, b);
+    check("Submul to Zero", acc, "0");
+    acc = c;
+    addmul(acc, a, -7);
+    check("Addmul Native Integer", acc, "-864197523067973008234932423614");
+    acc = c;
+    addmul(acc, a, UINT64_MAX);
+    check("Addmul uint64_t", acc, "2277375791072698140124934049028662773183886193966");
+    acc = a;
+    addmul(acc, acc, acc);
+    check("Accumulator as Factor", acc, a + a * a);
+
+    // Dot product of 3^i and -7^i
+    bigint dot;
+    bigint x("1"), y("-1");
+    for (int i = 1; i < 30; ++i)
+    {
+        x *= 3;
+        y *= 7;
+        addmul(dot, x, y);
+    }
+    check("Dot Product", dot, "-232032514455858205026002566678301832729");
+
+    // Row-by-row and scratch-space paths, in binary and decimal limbs
+    bool same = true;
+    for (size_t digits : {5, 50, 600, 6000})
+    {
+        bigint p(std::string(digits, '7')), q("-" + std::string(digits / 3 + 1, '3')), r(std::string(digits, '9'));
+        bigint s = r;
+        addmul(s, p, q);
+        submul(s, q, q);
+        same = same && s == r + p * q - q * q;
+        decimal_bigint dp(p.get_value()), dq(q.get_value()), ds(r.get_value());
+        submul(ds, dp, dq);
+        addmul(ds, dp, 999999999999999999LL);
+        same = same && ds.get_value() == (r - p * q + p * 999999999999999999LL).get_value();
+    }
+    check("Same as Eager Operators", same, true);
 }
 
 /**
@@ -917,6 +1528,34 @@ void Not_Equal_Operator()
     check("Zero != Negative Zero", (bigint("0") != bigint("-0")), false);
 }
 
+/**
+ * @brief Tests operator<=> and compare_magnitude, on which the relational operators are built.
+ */
+void Three_Way_Comparison()
+{
+    std::cout << "\n Test Three-Way Comparison (<=>, compare_magnitude)\n";
+
+    bigint a("340282366920938463463374607431768211456"); // 2^128
+    bigint b("340282366920938463463374607431768211455");
+    check("Greater", (a <=> b) == std::strong_ordering::greater, true);
+    check("Less", (b <=> a) == std::strong_ordering::less, true);
+    check("Equal", (a <=> bigint(a)) == std::strong_ordering::equal, true);
+    check("Negative Order", (-a <=> -b) == std::strong_ordering::less, true);
+    check("Sign First", (bigint("-1") <=> bigint("0")) == std::strong_ordering::less, true);
+    check("Zero and Negative Zero", (bigint("0") <=> bigint("-0")) == std::strong_ordering::equal, true);
+    check("Magnitude", compare_magnitude(-a, b) == std::strong_ordering::greater, true);
+    check("Magnitude Equal", compare_magnitude(-a, a) == std::strong_ordering::equal, true);
+
+    // Values that differ only in their lowest limb, and sorting
+    std::vector<bigint> v;
+    for (int i = 9; i >= -9; --i)
+    {
+        v.push_back(a * bigint(1000000) + bigint(i));
+    }
+    std::sort(v.begin(), v.end());
+    check("Sort", std::is_sorted(v.begin(), v.end()) && v.front() == a * bigint(1000000) - bigint(9), true);
+}
+
 /**
  * @brief Tests the operator<< for bigint output.
  */
@@ -935,6 +1574,142 @@ void Output_Operator()
     check_output("Negative Zero", bigint("-0"), "0");
 }
 
+/**
+ * @brief Tests the decimal conversion of long values, which divides by powers of 10^19 recursively.
+ *
+ * The values are computed, not parsed, so the digits are checked against a conversion that does not divide.
+ */
+void Long_Value_Conversion()
+{
+    std::cout << "\n Test Long Value Conversion\n";
+
+    // 10^n and 10^n - 1 around the sizes where the conversion splits and where it switches to Barrett division
+    for (int64_t digits : {570, 600, 1000, 4000, 30000})
+    {
+        bigint power = pow(bigint(10), bigint(digits));
+        const std::string length = std::to_string(digits) + " Digits";
+        check("Power of Ten to " + length, power.get_value() == "1" + std::string(digits, '0'), true);
+        check("All Nines to " + length, (power - bigint(1)).get_value() == std::string(digits, '9'), true);
+        check("Negative to " + length, (bigint(7) - power).get_value() == "-" + std::string(digits - 1, '9') + "3", true);
+    }
+
+    // 2^(64 * 2000) has no zero limbs below its top one: parse its digits back
+    bigint two = pow(bigint(2), bigint(64 * 2000));
+    check("Round Trip of a Power of Two", bigint(two.get_value()) == two, true);
+
+    // The stream gets the digits in one write, or padded when a field width is set
+    std::ostringstream os;
+    os << -pow(bigint(10), bigint(100)) << "|" << std::setw(6) << bigint(-42) << "|" << std::setw(0) << bigint(0);
+    check("Stream Output", os.str() == "-1" + std::string(100, '0') + "|   -42|0", true);
+
+    // Decimal limbs, with zero limbs inside the value
+    check("Decimal Limbs", decimal_bigint("-1" + std::string(40, '0') + "5").get_value(), "-1" + std::string(40, '0') + "5");
+}
+
+/**
+ * @brief Tests to_chars and from_chars on caller-provided buffers, digits10_upper_bound() and std::format.
+ */
+void Character_Conversions()
+{
+    std::cout << "\n Test Character Conversions (to_chars, from_chars)\n";
+
+    // to_chars writes no terminating null, and the bound is enough for it
+    char buffer[64];
+    bigint a("-123456789012345678901234567890");
+    std::to_chars_result written = to_chars(buffer, buffer + sizeof(buffer), a);
+    check("To Chars", std::string(buffer, written.ptr), "-123456789012345678901234567890");
+    check("To Chars Error Code", written.ec == std::errc(), true);
+    check("Digits10 Upper Bound", a.digits10_upper_bound() >= 31 && a.digits10_upper_bound() <= 32, true);
+    check("Digits10 Upper Bound of Zero", bigint(0).digits10_upper_bound() == 1, true);
+    check("Digits10 Upper Bound (decimal)", decimal_bigint("-1000000000000000000000").digits10_upper_bound() == 23, true);
+
+    // A buffer shorter than the bound still works when the digits fit, a shorter one reports the error
+    bigint b("99999999999999999999"); // 67 bits: the bound is 21 characters for 20 digits
+    written = to_chars(buffer, buffer + 20, b);
+    check("To Chars Exact Buffer", written.ec == std::errc() && std::string(buffer, written.ptr) == "99999999999999999999", true);
+    written = to_chars(buffer, buffer + 19, b);
+    check("To Chars Too Small", written.ec == std::errc::value_too_large && written.ptr == buffer + 19, true);
+
+    // from_chars stops at the first character that is not a digit
+    bigint c;
+    const std::string text = "-000123456789012345678901234567890xyz";
+    std::from_chars_result parsed = from_chars(text.data(), text.data() + text.size(), c);
+    check("From Chars", c, "-123456789012345678901234567890");
+    check("From Chars End", parsed.ec == std::errc() && parsed.ptr == text.data() + text.size() - 3, true);
+    const std::string zero = "-0";
+    from_chars(zero.data(), zero.data() + zero.size(), c);
+    check("From Chars Negative Zero", c, "0");
+
+    // No digit: an error, and the value is unchanged
+    c = bigint(42);
+    for (const std::string bad : {"", "-", "+1", " 1", "x"})
+    {
+        parsed = from_chars(bad.data(), bad.data() + bad.size(), c);
+        check("From Chars \"" + bad + "\"", parsed.ec == std::errc::invalid_argument && parsed.ptr == bad.data() && c == bigint(42), true);
+    }
+
+    // Long values go through the divide-and-conquer conversions both ways
+    const bigint big = pow(bigint(-3), bigint(20001));
+    std::vector<char> chars(big.digits10_upper_bound());
+    written = to_chars(chars.data(), chars.data() + chars.size(), big);
+    bigint back;
+    from_chars(chars.data(), written.ptr, back);
+    check("Long Round Trip", written.ec == std::errc() && back == big && std::string(chars.data(), written.ptr) == big.get_value(), true);
+
+#if defined(__cpp_lib_format)
+    check("Format", std::format("[{}] [{:>6}]", a, bigint(-42)) == "[-123456789012345678901234567890] [   -42]", true);
+#endif
+}
+
+/**
+ * @brief Tests the string constructor, get_value, to_chars and from_chars in bases other than 10.
+ */
+void Radix_Conversions()
+{
+    std::cout << "\n Test Radix Conversions (bases 2 to 36)\n";
+
+    // Power-of-two bases, with letters of either case on input and lowercase on output
+    bigint a("-DeadBeefCafe0123456789abcdef", 16);
+    check("Hexadecimal Constructor", a, "-4516460496169379092499323127844335");
+    check("Hexadecimal Output", a.get_value(16) == "-deadbeefcafe0123456789abcdef", true);
+    check("Octal Output", bigint("511").get_value(8) == "777", true);
+    check("Binary Output", bigint("-10").get_value(2) == "-1010", true);
+    check("Octal Across Limbs", bigint("1777777777777777777777777", 8), "9444732965739290427391"); // 2^73 - 1
+    check("Base 32 Across Limbs", bigint("vvvvvvvvvvvvvvvvv", 32).get_value(32) == "vvvvvvvvvvvvvvvvv", true);
+    check("Leading Zeros", bigint("-0000ff", 16), "-255");
+    check("Zero", bigint("-0", 2).get_value(16) == "0", true);
+
+    // Other bases, and decimal limbs
+    check("Base 36", bigint("zz", 36), "1295");
+    check("Base 3 Output", bigint("-100").get_value(3) == "-10201", true);
+    check("Decimal Limbs Hexadecimal", decimal_bigint("ffffffffffffffffffffffffffffffff", 16).get_value(), "340282366920938463463374607431768211455");
+    check("Decimal Limbs Binary Output", decimal_bigint("1000000000000000000").get_value(2) == "110111100000101101101011001110100111011001000000000000000000", true);
+
+    // Long values round trip through every base, and the bound is enough
+    const bigint big = pow(bigint(-7), bigint(3001));
+    bool round_trip = true;
+    for (int base = 2; base <= 36; ++base)
+    {
+        const std::string text = big.get_value(base);
+        round_trip = round_trip && bigint(text, base) == big && text.size() <= big.digits_upper_bound(base);
+    }
+    check("Long Round Trip (all bases)", round_trip, true);
+    check("Digits Upper Bound (hexadecimal)", bigint("65536").digits_upper_bound(16) == 5, true);
+
+    // to_chars and from_chars with a base
+    char buffer[64];
+    std::to_chars_result written = to_chars(buffer, buffer + sizeof(buffer), a, 16);
+    check("To Chars Hexadecimal", std::string(buffer, written.ptr) == "-deadbeefcafe0123456789abcdef", true);
+    written = to_chars(buffer, buffer + 5, bigint(1000000), 2);
+    check("To Chars Too Small", written.ec == std::errc::value_too_large, true);
+    bigint c;
+    const std::string text = "7fG";
+    std::from_chars_result parsed = from_chars(text.data(), text.data() + text.size(), c, 16);
+    check("From Chars Hexadecimal", c == bigint(127) && parsed.ptr == text.data() + 2, true);
+    parsed = from_chars(text.data(), text.data() + text.size(), c, 2);
+    check("From Chars No Digit", parsed.ec == std::errc::invalid_argument && c == bigint(127), true);
+}
+
 /**
  * @brief Tests the pow function.
  */
@@ -973,6 +1748,35 @@ void Trim_Function()
     check("Trim Large numbers with 1000 Zeros", large_num, "123");
 }
 
+/**
+ * @brief Tests the decimal limb radices of basic_bigint (10^9 and decimal_bigint with 10^18).
+ */
+void Decimal_Radix()
+{
+    std::cout << "\n Test Decimal Radix\n";
+
+    // Construct and output across several limbs
+    decimal_bigint a("-123456789012345678901234567890");
+    check("Decimal String Constructor", a.get_value(), "-123456789012345678901234567890");
+    check("Decimal Integer Constructor", decimal_bigint(INT64_MIN).get_value(), "-9223372036854775808");
+    check("Decimal Leading Zeros", decimal_bigint("000000000000000000000000123").get_value(), "123");
+    std::ostringstream oss;
+    oss << basic_bigint<1000000000>("1000000000000000000000000000");
+    check("Decimal Output", oss.str(), "1000000000000000000000000000");
+
+    // Carry and borrow across limb boundaries
+    check("Decimal Carry", (decimal_bigint("999999999999999999") + decimal_bigint("1")).get_value(), "1000000000000000000");
+    check("Decimal Borrow", (basic_bigint<1000000000>("1000000000") - basic_bigint<1000000000>("1")).get_value(), "999999999");
+
+    // Multiplication, division and modulus give the same results as the binary bigint
+    decimal_bigint b("99999999999999999999999999");
+    decimal_bigint c("-123456789123456789");
+    check("Decimal Multiplication", (b * c).get_value(), (bigint(b.get_value()) * bigint(c.get_value())).get_value());
+    check("Decimal Division", (b / c).get_value(), "-810000006");
+    check("Decimal Modulus", (b % c).get_value(), "69259266169259265");
+    check("Decimal Power", pow(basic_bigint<1000000000>(2), basic_bigint<1000000000>(100)).get_value(), "1267650600228229401496703205376");
+}
+
 // ==================================
 //        Integration Test
 // ==================================
@@ -1089,6 +1893,32 @@ void Error_Tests()
         ++pass_error;
     }
 
+    // Input with a digit outside the base error test.
+    try
+    {
+        bigint f("0x1f", 16);
+        std::cout << "Fail: Digit outside the base.\n";
+        ++fail_error;
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << "Pass: Digit outside the base: Exception caught: " << e.what() << "\n";
+        ++pass_error;
+    }
+
+    // Base out of range error test.
+    try
+    {
+        bigint g("10", 37);
+        std::cout << "Fail: Base out of range.\n";
+        ++fail_error;
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << "Pass: Base out of range: Exception caught: " << e.what() << "\n";
+        ++pass_error;
+    }
+
     // Test string assignment
     // Empty string assignment
     try
@@ -1173,6 +2003,19 @@ void Error_Tests()
         ++pass_error;
     }
 
+    // Division by zero in divmod
+    try
+    {
+        auto result = divmod(bigint("1111111"), bigint("0"));
+        std::cout << "Fail: Divmod by zero.\n";
+        ++fail_error;
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << "Pass: Divmod by zero: Exception caught: " << e.what() << "\n";
+        ++pass_error;
+    }
+
     // Negative exponent in pow
     try
     {
@@ -1305,6 +2148,25 @@ void Multiplication_Division_Consistency(int64_t count = 5)
     }
 }
 
+/**
+ * @brief Tests that decimal limbs (decimal_bigint) and binary limbs (bigint) give the same results for random bigints.
+ *
+ * @param count Number of random tests to run.
+ */
+void Radix_Consistency(int64_t count = 5)
+{
+    std::cout << "\n Test Decimal and Binary Radix Consistency\n";
+
+    for (int64_t i = 0; i < count; ++i)
+    {
+        std::string A = Random_Bigint(40);
+        std::string B = Random_Bigint(21);
+        decimal_bigint decimal = (decimal_bigint(A) * decimal_bigint(B) + decimal_bigint(A)) / decimal_bigint(B);
+        bigint binary = (bigint(A) * bigint(B) + bigint(A)) / bigint(B);
+        check_consistency("Decimal and Binary Radix", bigint(decimal.get_value()), binary);
+    }
+}
+
 // ==================================
 //        Strees Test
 // ==================================
@@ -1389,20 +2251,40 @@ int main()
     String_Constructor();
     Copy_Constructor();
     Assignment_Operator();
+    Move_And_Swap();
+    Inline_Limbs();
+    Pmr_Allocator();
     Int64_Assignment_Operator();
     String_Assignment_Operator();
+    Long_String_Conversion();
     Get_Value();
+    Long_Value_Conversion();
+    Character_Conversions();
+    Radix_Conversions();
     Get_Positive();
     Plus_Equal_Operator();
     Plus_Operator();
     Subtraction_Equal_Operator();
     Subtraction_Operator();
+    Vectorized_Kernels();
     Multiply_Equal_Operator();
     Multiplication_Operator();
+    Karatsuba_Multiplication();
+    Toom_Cook_Multiplication();
+    FFT_Multiplication();
+    Squaring();
     Division_Equal_Operator();
     Division_Operator();
+    Long_Division();
+    Recursive_Division();
+    Scratch_Reuse();
     Modulus_Equal_Operator();
     Modulus_Operator();
+    Divmod_Function();
+    Native_Integer_Operators();
+    Rvalue_Operators();
+    Expression_Templates();
+    Fused_Multiply_Accumulate();
     Prefix_Increment_Operator();
     Prefix_Decrement_Operator();
     Postfix_Increment_Operator();
@@ -1415,8 +2297,10 @@ int main()
     Less_Operator();
     Less_Or_Equal_Operator();
     Not_Equal_Operator();
+    Three_Way_Comparison();
     Power_Function();
     Trim_Function();
+    Decimal_Radix();
     std::cout << "_______Unit Test Finish line_______\n";
 
     // Integration Tests
@@ -1436,6 +2320,7 @@ int main()
     Distributive_Multiplication_Consistency();
     Distributive_Division_Consistency();
     Multiplication_Division_Consistency();
+    Radix_Consistency();
     std::cout << "_______Consistency Test Finish line_______\n\n";
 
     // Stress Test